@@ -0,0 +1,94 @@
+#include "asyncsocket.h"
+
+AsyncSocket::Awaitable::Awaitable(AsyncSocket& socket, bool write)
+    : m_socket(socket)
+    , m_write(write)
+{
+}
+
+void AsyncSocket::Awaitable::await_suspend(std::coroutine_handle<> coroutine)
+{
+    if (m_write)
+    {
+        m_socket.m_scheduler.ResumeWhenWritable(*m_socket.m_socket, coroutine);
+    }
+    else
+    {
+        m_socket.m_scheduler.ResumeWhenReadable(*m_socket.m_socket, coroutine);
+    }
+}
+
+AsyncSocket::ReadAwaitable::ReadAwaitable(AsyncSocket& socket, char* buffer, size_t size)
+    : Awaitable(socket, false)
+    , m_buffer(buffer)
+    , m_size(size)
+{
+}
+
+size_t AsyncSocket::ReadAwaitable::await_resume()
+{
+    return m_socket.m_socket->Read(m_buffer, m_size);
+}
+
+AsyncSocket::AcceptAwaitable::AcceptAwaitable(AsyncSocket& socket)
+    : Awaitable(socket, false)
+{
+}
+
+ISocketWrapperPtr AsyncSocket::AcceptAwaitable::await_resume()
+{
+    return m_socket.m_socket->Accept();
+}
+
+AsyncSocket::AsyncSocket(const ISocketWrapperPtr& socket, ICoScheduler& scheduler)
+    : m_socket(socket)
+    , m_scheduler(scheduler)
+{
+}
+
+ISocketWrapper& AsyncSocket::Socket()
+{
+    return *m_socket;
+}
+
+AsyncSocket::ReadAwaitable AsyncSocket::Read(char* buffer, size_t size)
+{
+    return ReadAwaitable(*this, buffer, size);
+}
+
+CoTask<void> AsyncSocket::Write(const std::string& buffer)
+{
+    size_t sent = 0;
+    while (sent < buffer.size())
+    {
+        co_await Writable();
+        const ConstBuffer rest = { buffer.data() + sent, buffer.size() - sent };
+        sent += m_socket->TryWriteV(&rest, 1);
+    }
+}
+
+AsyncSocket::AcceptAwaitable AsyncSocket::Accept()
+{
+    return AcceptAwaitable(*this);
+}
+
+CoTask<ISocketWrapperPtr> AsyncSocket::Connect(std::string addr, int16_t port)
+{
+    ISocketWrapperPtr connected = m_socket->TryConnect(addr, port);
+    if (!connected)
+    {
+        co_await Writable();
+        connected = m_socket->FinishConnect();
+    }
+    co_return connected;
+}
+
+AsyncSocket::Awaitable AsyncSocket::Readable()
+{
+    return Awaitable(*this, false);
+}
+
+AsyncSocket::Awaitable AsyncSocket::Writable()
+{
+    return Awaitable(*this, true);
+}
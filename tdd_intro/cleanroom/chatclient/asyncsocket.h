@@ -0,0 +1,72 @@
+#pragma once
+#include <coroutine>
+#include "cotask.h"
+#include "icoscheduler.h"
+#include "isocketwrapper.h"
+
+/*
+ * Awaitable operations of ISocketWrapper for coroutines.
+ *
+ * co_await of an operation suspends the coroutine until the scheduler finds the socket ready for it,
+ * then performs the operation of ISocketWrapper, which doesn't wait anymore.
+ * Write sends only what the socket takes right away and co_awaits the writability again for the rest.
+ * Connect starts connecting without waiting and co_awaits the writability, which means the connection
+ * is established or has failed.
+ * So a handshake or a message loop is written as straight-line code, while one thread serves many sockets.
+ * Exceptions of ISocketWrapper are thrown from co_await.
+*/
+
+class AsyncSocket
+{
+public:
+    // Suspends the coroutine until the socket is ready for reading or writing
+    class Awaitable
+    {
+    public:
+        Awaitable(AsyncSocket& socket, bool write);
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> coroutine);
+        void await_resume() { }
+
+    protected:
+        AsyncSocket& m_socket;
+        bool m_write;
+    };
+
+    class ReadAwaitable : public Awaitable
+    {
+    public:
+        ReadAwaitable(AsyncSocket& socket, char* buffer, size_t size);
+        size_t await_resume();
+
+    private:
+        char* m_buffer;
+        size_t m_size;
+    };
+
+    class AcceptAwaitable : public Awaitable
+    {
+    public:
+        explicit AcceptAwaitable(AsyncSocket& socket);
+        ISocketWrapperPtr await_resume();
+    };
+
+    AsyncSocket(const ISocketWrapperPtr& socket, ICoScheduler& scheduler);
+
+    ISocketWrapper& Socket();
+
+    // See ISocketWrapper for the meaning of the operations.
+    // Buffers are passed by reference and must stay valid until co_await returns.
+    ReadAwaitable Read(char* buffer, size_t size);
+    CoTask<void> Write(const std::string& buffer);
+    AcceptAwaitable Accept();
+    CoTask<ISocketWrapperPtr> Connect(std::string addr, int16_t port);
+    // Only waits for the data to read, to be used with the readers like MessageFramer::Receive.
+    Awaitable Readable();
+    // Only waits until the socket can take data to write, to be used with TryWriteV.
+    Awaitable Writable();
+
+private:
+    ISocketWrapperPtr m_socket;
+    ICoScheduler& m_scheduler;
+};
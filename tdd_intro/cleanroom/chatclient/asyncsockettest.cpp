@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include "asyncsocket.h"
+#include "cotask.h"
+#include "mocks.h"
+
+using namespace testing;
+
+namespace
+{
+    CoTask<size_t> ReadInto(AsyncSocket& socket, std::string& received)
+    {
+        char buffer[64];
+        size_t size = co_await socket.Read(buffer, sizeof(buffer));
+        received.assign(buffer, size);
+        co_return size;
+    }
+
+    CoTask<void> WriteTwice(AsyncSocket& socket)
+    {
+        co_await socket.Write("first");
+        co_await socket.Write("second");
+    }
+
+    CoTask<ISocketWrapperPtr> AcceptOne(AsyncSocket& socket)
+    {
+        co_return co_await socket.Accept();
+    }
+
+    CoTask<ISocketWrapperPtr> ConnectTo(AsyncSocket& socket)
+    {
+        co_return co_await socket.Connect("127.0.0.1", 4444);
+    }
+}
+
+TEST(AsyncSocketTest, ReadWaitsForSchedulerBeforeReading)
+{
+    auto mock = std::make_shared<SocketWrapperMock>();
+    CoSchedulerFake scheduler;
+    AsyncSocket socket(mock, scheduler);
+    std::string received;
+
+    auto task = ReadInto(socket, received);
+    task.Start();
+    EXPECT_FALSE(task.IsDone());
+    EXPECT_EQ(1u, scheduler.GetWaitingCount());
+
+    EXPECT_CALL(*mock, Read(_, _)).WillOnce(Invoke([](char* buffer, size_t)
+    {
+        std::memcpy(buffer, "hello", 5);
+        return 5;
+    }));
+    scheduler.RunUntilIdle();
+
+    ASSERT_TRUE(task.IsDone());
+    EXPECT_EQ(5u, task.Result());
+    EXPECT_EQ("hello", received);
+}
+
+TEST(AsyncSocketTest, WritesInOrderOfAwaiting)
+{
+    auto mock = std::make_shared<SocketWrapperMock>();
+    CoSchedulerFake scheduler;
+    AsyncSocket socket(mock, scheduler);
+
+    std::string written;
+    EXPECT_CALL(*mock, TryWriteV(_, 1u)).WillRepeatedly(Invoke([&written](const ConstBuffer* buffers, size_t)
+    {
+        written.append(buffers[0].data, buffers[0].size);
+        return buffers[0].size;
+    }));
+
+    auto task = WriteTwice(socket);
+    task.Start();
+    EXPECT_EQ(2u, scheduler.RunUntilIdle());
+    EXPECT_TRUE(task.IsDone());
+    EXPECT_EQ("firstsecond", written);
+}
+
+TEST(AsyncSocketTest, WriteAwaitsWritabilityForRestOfPartialSend)
+{
+    auto mock = std::make_shared<SocketWrapperMock>();
+    CoSchedulerFake scheduler;
+    AsyncSocket socket(mock, scheduler);
+
+    std::string written;
+    auto takePortion = [&written](size_t portion)
+    {
+        return [&written, portion](const ConstBuffer* buffers, size_t)
+        {
+            written.append(buffers[0].data, portion);
+            return portion;
+        };
+    };
+    EXPECT_CALL(*mock, TryWriteV(_, 1u))
+            .WillOnce(Invoke(takePortion(2)))
+            .WillOnce(Invoke(takePortion(0)))
+            .WillOnce(Invoke(takePortion(3)))
+            .WillOnce(Invoke(takePortion(6)));
+
+    auto task = WriteTwice(socket);
+    task.Start();
+    EXPECT_EQ(4u, scheduler.RunUntilIdle());
+    EXPECT_TRUE(task.IsDone());
+    EXPECT_EQ("firstsecond", written);
+}
+
+TEST(AsyncSocketTest, AcceptReturnsAcceptedSocket)
+{
+    auto listener = std::make_shared<SocketWrapperMock>();
+    auto accepted = std::make_shared<SocketWrapperMock>();
+    CoSchedulerFake scheduler;
+    AsyncSocket socket(listener, scheduler);
+
+    EXPECT_CALL(*listener, Accept()).WillOnce(Return(accepted));
+
+    auto task = AcceptOne(socket);
+    task.Start();
+    scheduler.RunUntilIdle();
+
+    ASSERT_TRUE(task.IsDone());
+    EXPECT_EQ(accepted, task.Result());
+}
+
+TEST(AsyncSocketTest, ConnectEstablishedRightAwayDoesNotSuspend)
+{
+    auto client = std::make_shared<SocketWrapperMock>();
+    auto connected = std::make_shared<SocketWrapperMock>();
+    CoSchedulerFake scheduler;
+    AsyncSocket socket(client, scheduler);
+
+    EXPECT_CALL(*client, TryConnect("127.0.0.1", 4444)).WillOnce(Return(connected));
+    EXPECT_CALL(*client, FinishConnect()).Times(0);
+
+    auto task = ConnectTo(socket);
+    task.Start();
+
+    ASSERT_TRUE(task.IsDone());
+    EXPECT_EQ(connected, task.Result());
+}
+
+TEST(AsyncSocketTest, ConnectInProgressAwaitsWritability)
+{
+    auto client = std::make_shared<SocketWrapperMock>();
+    auto connected = std::make_shared<SocketWrapperMock>();
+    CoSchedulerFake scheduler;
+    AsyncSocket socket(client, scheduler);
+
+    EXPECT_CALL(*client, TryConnect("127.0.0.1", 4444)).WillOnce(Return(nullptr));
+
+    auto task = ConnectTo(socket);
+    task.Start();
+    EXPECT_FALSE(task.IsDone());
+    EXPECT_EQ(1u, scheduler.GetWaitingCount());
+
+    EXPECT_CALL(*client, FinishConnect()).WillOnce(Return(connected));
+    scheduler.RunUntilIdle();
+
+    ASSERT_TRUE(task.IsDone());
+    EXPECT_EQ(connected, task.Result());
+}
+
+TEST(AsyncSocketTest, ExceptionOfSocketIsThrownFromTask)
+{
+    auto mock = std::make_shared<SocketWrapperMock>();
+    CoSchedulerFake scheduler;
+    AsyncSocket socket(mock, scheduler);
+    std::string received;
+
+    EXPECT_CALL(*mock, Read(_, _)).WillOnce(Throw(std::runtime_error("Failed to read data.")));
+
+    auto task = ReadInto(socket, received);
+    task.Start();
+    scheduler.RunUntilIdle();
+
+    ASSERT_TRUE(task.IsDone());
+    EXPECT_THROW(task.Result(), std::runtime_error);
+}
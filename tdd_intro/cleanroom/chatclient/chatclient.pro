@@ -1,22 +1,112 @@
 include(../../gmock.pri)
 
 TEMPLATE = app
-CONFIG += console c++11
+CONFIG += console c++2a
 CONFIG -= app_bundle
 CONFIG -= qt
 
 SOURCES += \
     test.cpp \
-    socketwrapper.cpp \
-    socketwrappertest.cpp
-
-LIBS += \
-    Ws2_32.lib \
-    Mswsock.lib \
-    AdvApi32.lib
+    socketwrappertest.cpp \
+    socketwrapperbenchmark.cpp \
+    messageframer.cpp \
+    messageframertest.cpp \
+    messageframerbenchmark.cpp \
+    chathandshake.cpp \
+    chathandshaketest.cpp \
+    chatserver.cpp \
+    chatservertest.cpp \
+    workstealingexecutor.cpp \
+    workstealingexecutortest.cpp \
+    spscqueuetest.cpp \
+    spscqueuebenchmark.cpp \
+    asyncsocket.cpp \
+    asyncsockettest.cpp \
+    chatcoroutines.cpp \
+    chatcoroutinestest.cpp \
+    slaballocatortest.cpp \
+    slaballocatorbenchmark.cpp \
+    outboundqueue.cpp \
+    outboundqueuetest.cpp \
+    timer.cpp \
+    timertest.cpp \
+    transmitbatcher.cpp \
+    transmitbatchertest.cpp \
+    loopbacksocketwrapper.cpp \
+    loopbacksocketwrappertest.cpp \
+    latencyrecorder.cpp \
+    latencyrecordertest.cpp \
+    latencyrecorderbenchmark.cpp
 
 HEADERS += \
     socketwrapper.h \
     mocks.h \
     isocketwrapper.h \
-    igui.h
+    igui.h \
+    messageframer.h \
+    chathandshake.h \
+    chatserver.h \
+    workstealingexecutor.h \
+    spscqueue.h \
+    cotask.h \
+    icoscheduler.h \
+    asyncsocket.h \
+    chatcoroutines.h \
+    slaballocator.h \
+    outboundqueue.h \
+    itimer.h \
+    timer.h \
+    transmitbatcher.h \
+    loopbacksocketwrapper.h \
+    latencyrecorder.h
+
+win32 {
+    DEFINES += NOMINMAX
+
+    SOURCES += \
+        socketwrapper.cpp
+
+    LIBS += \
+        Ws2_32.lib \
+        Mswsock.lib \
+        AdvApi32.lib
+}
+
+unix {
+    SOURCES += \
+        epollreactor.cpp \
+        socketwrapper_posix.cpp \
+        chatserverloop.cpp \
+        chatserverbenchmark.cpp \
+        workstealingexecutorbenchmark.cpp \
+        epollcoscheduler.cpp \
+        epollcoschedulertest.cpp \
+        outboundqueuebenchmark.cpp \
+        transmitbatcherbenchmark.cpp \
+        loopbacksocketwrapperbenchmark.cpp
+
+    HEADERS += \
+        epollreactor.h \
+        chatserverloop.h \
+        epollcoscheduler.h
+
+    LIBS += -lpthread
+}
+
+linux {
+    SOURCES += \
+        iouring.cpp \
+        uringsocketwrapper.cpp \
+        uringsocketwrappertest.cpp \
+        uringsocketwrapperbenchmark.cpp
+
+    HEADERS += \
+        iouring.h \
+        uringsocketwrapper.h
+}
+
+# Build with `qmake CONFIG+=tsan` to run the tests under ThreadSanitizer
+tsan {
+    QMAKE_CXXFLAGS += -fsanitize=thread
+    QMAKE_LFLAGS += -fsanitize=thread
+}
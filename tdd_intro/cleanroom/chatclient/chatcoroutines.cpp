@@ -0,0 +1,78 @@
+#include <stdexcept>
+
+#include "chatcoroutines.h"
+#include "chathandshake.h"
+
+CoTask<bool> ReadMessage(AsyncSocket& socket, MessageFramer& framer, std::string_view& message)
+{
+    while (!framer.NextMessage(message))
+    {
+        co_await socket.Readable();
+        if (!framer.Receive())
+        {
+            co_return false;
+        }
+    }
+    co_return true;
+}
+
+CoTask<std::string> ClientHandshake(AsyncSocket& socket, MessageFramer& framer, std::string nickname,
+                                    MessageFramer::Framing framing)
+{
+    co_await socket.Write(MakeHello(nickname, framing));
+
+    std::string_view response;
+    if (!co_await ReadMessage(socket, framer, response))
+    {
+        throw std::runtime_error("Connection is closed during handshake.");
+    }
+    MessageFramer::Framing confirmed;
+    std::string_view friendName = ParseHello(response, confirmed);
+    // Server confirms only the framing offered to it
+    if (friendName.empty() || (confirmed == MessageFramer::Framing::LengthPrefixed && confirmed != framing))
+    {
+        throw std::runtime_error("Malformated handshake response.");
+    }
+    if (confirmed == MessageFramer::Framing::LengthPrefixed)
+    {
+        framer.SetFraming(confirmed);
+    }
+    co_return std::string(friendName);
+}
+
+CoTask<void> ReceiveMessages(AsyncSocket& socket, MessageFramer& framer, IGui& gui, std::string friendName,
+                             LatencyRecorder* recorder)
+{
+    std::string_view message;
+    for (;;)
+    {
+        // Same as ReadMessage, but the stages are measured separately and without the wait for readiness
+        bool parsed;
+        {
+            // Only the parses returning a message are measured, so the misses don't skew the percentiles
+            LatencyRecorder::Span span(recorder, LatencyRecorder::Stage::Parse);
+            parsed = framer.NextMessage(message);
+            if (!parsed)
+            {
+                span.Cancel();
+            }
+        }
+        if (parsed)
+        {
+            gui.Write(friendName + ": " + std::string(message));
+            continue;
+        }
+
+        co_await socket.Readable();
+        bool received;
+        {
+            LatencyRecorder::Span span(recorder, LatencyRecorder::Stage::Recv);
+            received = framer.Receive();
+        }
+        if (!received)
+        {
+            break;
+        }
+    }
+    gui.Write("You are alone now");
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include "asyncsocket.h"
+#include "cotask.h"
+#include "igui.h"
+#include "latencyrecorder.h"
+#include "messageframer.h"
+
+/*
+ * Chat client protocol written as coroutines over AsyncSocket.
+ *
+ * The framer must read from the same socket. Socket, framer and GUI are taken by reference,
+ * so they must outlive the returned tasks, strings are copied into the coroutines.
+*/
+
+// Reads the next complete message, suspending until the socket has more data.
+// Returns false when the connection is closed.
+CoTask<bool> ReadMessage(AsyncSocket& socket, MessageFramer& framer, std::string_view& message);
+
+// Client side of the handshake: writes "<nickname>:HELLO!" and waits for the same from the other side.
+// With LengthPrefixed framing "<nickname>:HELLO!v2" is written instead, and the framer is switched to it
+// if the other side confirms it with ":HELLO!v2". Old servers may not know v2, so it is not offered by default.
+// Returns the nickname of the other side, throws std::runtime_error if its response is malformated
+// or the connection is closed.
+CoTask<std::string> ClientHandshake(AsyncSocket& socket, MessageFramer& framer, std::string nickname,
+                                    MessageFramer::Framing framing = MessageFramer::Framing::Terminated);
+
+// Displays received messages prefixed with the friend's nickname ("metizik: Hello!")
+// until the connection is dropped, then displays "You are alone now".
+// Recv and Parse stages are measured, if the recorder is given (wrap the GUI into InstrumentedGui for Display).
+CoTask<void> ReceiveMessages(AsyncSocket& socket, MessageFramer& framer, IGui& gui, std::string friendName,
+                             LatencyRecorder* recorder = nullptr);
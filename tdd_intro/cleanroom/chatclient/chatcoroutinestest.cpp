@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include "chatcoroutines.h"
+#include "mocks.h"
+
+using namespace testing;
+
+TEST(ChatCoroutinesTest, HandshakeReturnsFriendNickname)
+{
+    auto stream = std::make_shared<SocketStreamFake>(std::string("server:HELLO!\0", 14));
+    CoSchedulerFake scheduler;
+    AsyncSocket socket(stream, scheduler);
+    MessageFramer framer(*stream);
+
+    auto task = ClientHandshake(socket, framer, "metizik");
+    task.Start();
+    scheduler.RunUntilIdle();
+
+    ASSERT_TRUE(task.IsDone());
+    EXPECT_EQ("server", task.Result());
+    EXPECT_EQ(std::string("metizik:HELLO!\0", 15), stream->Written());
+}
+
+TEST(ChatCoroutinesTest, HandshakeSwitchesToLengthPrefixedFramingWhenConfirmed)
+{
+    auto stream = std::make_shared<SocketStreamFake>(std::string("server:HELLO!v2\0\x02hi", 19));
+    CoSchedulerFake scheduler;
+    AsyncSocket socket(stream, scheduler);
+    MessageFramer framer(*stream);
+
+    auto task = ClientHandshake(socket, framer, "metizik", MessageFramer::Framing::LengthPrefixed);
+    task.Start();
+    scheduler.RunUntilIdle();
+
+    ASSERT_TRUE(task.IsDone());
+    EXPECT_EQ("server", task.Result());
+    EXPECT_EQ(std::string("metizik:HELLO!v2\0", 17), stream->Written());
+    EXPECT_EQ(MessageFramer::Framing::LengthPrefixed, framer.GetFraming());
+    std::string_view message;
+    ASSERT_TRUE(framer.NextMessage(message));
+    EXPECT_EQ("hi", message);
+}
+
+TEST(ChatCoroutinesTest, HandshakeKeepsTerminatedFramingWithOldServer)
+{
+    auto stream = std::make_shared<SocketStreamFake>(std::string("server:HELLO!\0", 14));
+    CoSchedulerFake scheduler;
+    AsyncSocket socket(stream, scheduler);
+    MessageFramer framer(*stream);
+
+    auto task = ClientHandshake(socket, framer, "metizik", MessageFramer::Framing::LengthPrefixed);
+    task.Start();
+    scheduler.RunUntilIdle();
+
+    ASSERT_TRUE(task.IsDone());
+    EXPECT_EQ("server", task.Result());
+    EXPECT_EQ(MessageFramer::Framing::Terminated, framer.GetFraming());
+}
+
+TEST(ChatCoroutinesTest, HandshakeWaitsForResponseSplitAcrossReads)
+{
+    auto stream = std::make_shared<SocketStreamFake>(std::string("server:HELLO!\0", 14), std::vector<size_t>{ 3, 5, 6 });
+    CoSchedulerFake scheduler;
+    AsyncSocket socket(stream, scheduler);
+    MessageFramer framer(*stream);
+
+    auto task = ClientHandshake(socket, framer, "metizik");
+    task.Start();
+
+    EXPECT_EQ(4u, scheduler.RunUntilIdle()); // Write and three reads
+    ASSERT_TRUE(task.IsDone());
+    EXPECT_EQ("server", task.Result());
+}
+
+TEST(ChatCoroutinesTest, HandshakeThrowsOnMalformatedResponse)
+{
+    auto stream = std::make_shared<SocketStreamFake>(std::string("server:HI!\0", 11));
+    CoSchedulerFake scheduler;
+    AsyncSocket socket(stream, scheduler);
+    MessageFramer framer(*stream);
+
+    auto task = ClientHandshake(socket, framer, "metizik");
+    task.Start();
+    scheduler.RunUntilIdle();
+
+    ASSERT_TRUE(task.IsDone());
+    EXPECT_THROW(task.Result(), std::runtime_error);
+}
+
+TEST(ChatCoroutinesTest, HandshakeThrowsWhenConnectionIsClosed)
+{
+    auto stream = std::make_shared<SocketStreamFake>("");
+    CoSchedulerFake scheduler;
+    AsyncSocket socket(stream, scheduler);
+    MessageFramer framer(*stream);
+
+    auto task = ClientHandshake(socket, framer, "metizik");
+    task.Start();
+    scheduler.RunUntilIdle();
+
+    ASSERT_TRUE(task.IsDone());
+    EXPECT_THROW(task.Result(), std::runtime_error);
+}
+
+TEST(ChatCoroutinesTest, ReceivesMessagesUntilConnectionIsDropped)
+{
+    auto stream = std::make_shared<SocketStreamFake>(std::string("Hello!\0How are you?\0", 20));
+    CoSchedulerFake scheduler;
+    AsyncSocket socket(stream, scheduler);
+    MessageFramer framer(*stream);
+    GuiMock gui;
+
+    InSequence sequence;
+    EXPECT_CALL(gui, Write("metizik: Hello!"));
+    EXPECT_CALL(gui, Write("metizik: How are you?"));
+    EXPECT_CALL(gui, Write("You are alone now"));
+
+    auto task = ReceiveMessages(socket, framer, gui, "metizik");
+    task.Start();
+    scheduler.RunUntilIdle();
+
+    EXPECT_TRUE(task.IsDone());
+}
+
+TEST(ChatCoroutinesTest, ReceiveMeasuresRecvAndParseStages)
+{
+    auto stream = std::make_shared<SocketStreamFake>(std::string("Hello!\0How are you?\0", 20));
+    CoSchedulerFake scheduler;
+    AsyncSocket socket(stream, scheduler);
+    MessageFramer framer(*stream);
+    NiceMock<GuiMock> gui;
+    TimeFake time;
+    LatencyRecorder recorder(time);
+
+    auto task = ReceiveMessages(socket, framer, gui, "metizik", &recorder);
+    task.Start();
+    scheduler.RunUntilIdle();
+
+    ASSERT_TRUE(task.IsDone());
+    EXPECT_EQ(2u, recorder.GetHistogram(LatencyRecorder::Stage::Recv).GetCount()); // Data and the end of stream
+    EXPECT_EQ(2u, recorder.GetHistogram(LatencyRecorder::Stage::Parse).GetCount()); // Misses are not measured
+}
@@ -0,0 +1,40 @@
+#include "chathandshake.h"
+
+namespace
+{
+    const std::string_view s_helloMagic = ":HELLO!";
+    const std::string_view s_lengthPrefixedMagic = "v2";
+
+    bool EndsWith(std::string_view text, std::string_view suffix)
+    {
+        return text.size() >= suffix.size() && text.substr(text.size() - suffix.size()) == suffix;
+    }
+}
+
+std::string MakeHello(std::string_view nickname, MessageFramer::Framing framing)
+{
+    std::string hello;
+    hello.reserve(nickname.size() + s_helloMagic.size() + s_lengthPrefixedMagic.size() + 1);
+    hello.append(nickname).append(s_helloMagic);
+    if (framing == MessageFramer::Framing::LengthPrefixed)
+    {
+        hello.append(s_lengthPrefixedMagic);
+    }
+    hello.push_back('\0');
+    return hello;
+}
+
+std::string_view ParseHello(std::string_view message, MessageFramer::Framing& framing)
+{
+    framing = MessageFramer::Framing::Terminated;
+    if (EndsWith(message, s_lengthPrefixedMagic))
+    {
+        framing = MessageFramer::Framing::LengthPrefixed;
+        message.remove_suffix(s_lengthPrefixedMagic.size());
+    }
+    if (message.size() <= s_helloMagic.size() || !EndsWith(message, s_helloMagic))
+    {
+        return std::string_view();
+    }
+    return message.substr(0, message.size() - s_helloMagic.size());
+}
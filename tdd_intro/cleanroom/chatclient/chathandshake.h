@@ -0,0 +1,20 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include "messageframer.h"
+
+/*
+ * Handshake messages of the chat protocol, the same for both sides of the connection.
+ *
+ * Each side sends its nickname followed by ':HELLO!' magic ("metizik:HELLO!").
+ * The client asks for the length prefixed framing by ':HELLO!v2' ("metizik:HELLO!v2"),
+ * the server confirms it in the same way (see ChatServer and ClientHandshake).
+ * Handshake messages are always '\0' terminated.
+*/
+
+// Whole handshake message of the given side, including the '\0' terminator.
+std::string MakeHello(std::string_view nickname, MessageFramer::Framing framing);
+
+// Parses the handshake message without the terminator and returns the nickname of the other side,
+// framing is set to LengthPrefixed if it is asked for or confirmed. Returns empty nickname if it is malformated.
+std::string_view ParseHello(std::string_view message, MessageFramer::Framing& framing);
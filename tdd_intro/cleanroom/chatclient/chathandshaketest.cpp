@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include "chathandshake.h"
+
+TEST(ChatHandshakeTest, MakesTerminatedHello)
+{
+    EXPECT_EQ(std::string("metizik:HELLO!\0", 15), MakeHello("metizik", MessageFramer::Framing::Terminated));
+}
+
+TEST(ChatHandshakeTest, MakesHelloAskingForLengthPrefixedFraming)
+{
+    EXPECT_EQ(std::string("metizik:HELLO!v2\0", 17), MakeHello("metizik", MessageFramer::Framing::LengthPrefixed));
+}
+
+TEST(ChatHandshakeTest, ParsesNicknameOfHello)
+{
+    MessageFramer::Framing framing;
+    EXPECT_EQ("metizik", ParseHello("metizik:HELLO!", framing));
+    EXPECT_EQ(MessageFramer::Framing::Terminated, framing);
+}
+
+TEST(ChatHandshakeTest, ParsesLengthPrefixedFraming)
+{
+    MessageFramer::Framing framing;
+    EXPECT_EQ("metizik", ParseHello("metizik:HELLO!v2", framing));
+    EXPECT_EQ(MessageFramer::Framing::LengthPrefixed, framing);
+}
+
+TEST(ChatHandshakeTest, ReturnsEmptyNicknameForMalformatedHello)
+{
+    MessageFramer::Framing framing;
+    EXPECT_TRUE(ParseHello("metizik:HI!", framing).empty());
+    EXPECT_TRUE(ParseHello(":HELLO!", framing).empty());
+    EXPECT_TRUE(ParseHello("metizikv2", framing).empty());
+}
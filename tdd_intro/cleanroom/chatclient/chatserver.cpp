@@ -0,0 +1,315 @@
+#include <stdexcept>
+#include <vector>
+
+#include "chatserver.h"
+#include "chathandshake.h"
+
+namespace
+{
+    const std::string_view s_nicknameSeparator = ": ";
+
+    // Whole broadcast frame "<nickname>: <message>" in the given framing
+    std::shared_ptr<std::string> MakeFrame(MessageFramer::Framing framing, const std::string& nickname, std::string_view message)
+    {
+        const size_t length = nickname.size() + s_nicknameSeparator.size() + message.size();
+        char prefix[MessageFramer::s_maxPrefixSize];
+        const size_t prefixSize = framing == MessageFramer::Framing::LengthPrefixed ? MessageFramer::EncodeLength(length, prefix) : 0;
+
+        auto frame = std::make_shared<std::string>();
+        frame->reserve(prefixSize + length + 1);
+        frame->append(prefix, prefixSize).append(nickname).append(s_nicknameSeparator).append(message);
+        if (framing == MessageFramer::Framing::Terminated)
+        {
+            frame->push_back('\0');
+        }
+        return frame;
+    }
+}
+
+ChatServer::Peer::Peer(const ISocketWrapperPtr& socket, size_t maxQueuedOutput)
+    : socket(socket)
+    , framer(*socket)
+    , output(*socket, 0, maxQueuedOutput) // Peer is dropped at the high watermark, so it never resumes
+    , state(PeerState::AwaitingHello)
+    , worker(0)
+{
+}
+
+ChatServer::ChatServer(const std::string& nickname, WorkStealingExecutor* writer, size_t maxQueuedOutput)
+    : m_nickname(nickname)
+    , m_writer(writer)
+    , m_maxQueuedOutput(maxQueuedOutput)
+    , m_nextWorker(0)
+{
+}
+
+void ChatServer::SetPeerRemovedHandler(PeerRemovedHandler handler)
+{
+    m_peerRemoved = std::move(handler);
+}
+
+void ChatServer::SetOutputWatchHandler(OutputWatchHandler handler)
+{
+    m_outputWatch = std::move(handler);
+}
+
+void ChatServer::AddPeer(const ISocketWrapperPtr& peer)
+{
+    RemoveFailedPeers();
+
+    std::unique_ptr<Peer>& added = m_peers[peer.get()];
+    added.reset(new Peer(peer, m_maxQueuedOutput));
+    if (m_writer)
+    {
+        added->worker = m_nextWorker++ % m_writer->GetWorkerCount();
+    }
+}
+
+bool ChatServer::OnReadable(ISocketWrapper& socket)
+{
+    RemoveFailedPeers();
+
+    auto found = m_peers.find(&socket);
+    if (found == m_peers.end())
+    {
+        return false;
+    }
+
+    Peer& peer = *found->second;
+    try
+    {
+        if (!peer.framer.Receive())
+        {
+            RemovePeer(socket);
+            return false;
+        }
+
+        std::string_view message;
+        while (peer.framer.NextMessage(message))
+        {
+            if (!ProcessMessage(peer, message))
+            {
+                RemovePeer(socket);
+                return false;
+            }
+        }
+    }
+    catch (const std::exception&)
+    {
+        RemovePeer(socket);
+        return false;
+    }
+    return true;
+}
+
+bool ChatServer::OnWritable(ISocketWrapper& socket)
+{
+    auto found = m_peers.find(&socket);
+    if (found == m_peers.end())
+    {
+        return false;
+    }
+
+    try
+    {
+        if (found->second->output.Flush() && m_outputWatch)
+        {
+            m_outputWatch(socket, false);
+        }
+    }
+    catch (const std::exception&)
+    {
+        RemovePeer(socket);
+        return false;
+    }
+    return true;
+}
+
+void ChatServer::RemovePeer(ISocketWrapper& peer)
+{
+    auto found = m_peers.find(&peer);
+    if (found == m_peers.end())
+    {
+        return;
+    }
+    if (m_peerRemoved)
+    {
+        m_peerRemoved(peer);
+    }
+    m_peers.erase(found);
+}
+
+void ChatServer::RemoveFailedPeers()
+{
+    std::vector<ISocketWrapperPtr> failed;
+    {
+        std::lock_guard<std::mutex> lock(m_failedMutex);
+        failed.swap(m_failed);
+    }
+
+    for (const auto& peer : failed)
+    {
+        RemovePeer(*peer);
+    }
+}
+
+ChatServer::PeerState ChatServer::GetPeerState(ISocketWrapper& peer) const
+{
+    auto found = m_peers.find(&peer);
+    return found == m_peers.end() ? PeerState::Closed : found->second->state;
+}
+
+size_t ChatServer::GetPeerCount() const
+{
+    return m_peers.size();
+}
+
+bool ChatServer::ProcessMessage(Peer& peer, std::string_view message)
+{
+    switch (peer.state)
+    {
+    case PeerState::AwaitingHello:
+        return ProcessHello(peer, message);
+    case PeerState::Established:
+        if (peer.nickname.size() + s_nicknameSeparator.size() + message.size() > MessageFramer::s_maxMessageSize)
+        {
+            return false; // Broadcast frame wouldn't fit into the length prefixed framing
+        }
+        Broadcast(peer, message);
+        return true;
+    case PeerState::Closed:
+        break;
+    }
+    return false;
+}
+
+bool ChatServer::ProcessHello(Peer& peer, std::string_view message)
+{
+    MessageFramer::Framing framing;
+    std::string_view nickname = ParseHello(message, framing);
+    if (nickname.empty())
+    {
+        return false;
+    }
+
+    peer.nickname.assign(nickname.data(), nickname.size());
+    // Response confirms the length prefixed framing, it is still terminated itself
+    const std::string response = MakeHello(m_nickname, framing);
+    const ConstBuffer buffer = { response.data(), response.size() };
+    Send(peer, &buffer, 1);
+    peer.framer.SetFraming(framing);
+    peer.state = PeerState::Established;
+    return true;
+}
+
+void ChatServer::Broadcast(const Peer& sender, std::string_view message)
+{
+    if (m_writer)
+    {
+        PostBroadcast(sender, message);
+        return;
+    }
+
+    // Prefix is encoded for the first length prefixed receiver, if there is any
+    char prefix[MessageFramer::s_maxPrefixSize];
+    // Terminated frame uses the last four buffers, length prefixed one the first four
+    ConstBuffer buffers[] = { { prefix, 0 },
+                              { sender.nickname.data(), sender.nickname.size() },
+                              { s_nicknameSeparator.data(), s_nicknameSeparator.size() },
+                              { message.data(), message.size() },
+                              { "", 1 } }; // '\0' terminator
+
+    std::vector<ISocketWrapper*> failed;
+    for (auto& item : m_peers)
+    {
+        Peer& receiver = *item.second;
+        if (&receiver == &sender || receiver.state != PeerState::Established)
+        {
+            continue;
+        }
+
+        try
+        {
+            const bool prefixed = receiver.framer.GetFraming() == MessageFramer::Framing::LengthPrefixed;
+            if (prefixed && buffers[0].size == 0)
+            {
+                buffers[0].size = MessageFramer::EncodeLength(sender.nickname.size() + s_nicknameSeparator.size() + message.size(), prefix);
+            }
+            Send(receiver, prefixed ? buffers : buffers + 1, 4);
+        }
+        catch (const std::exception&)
+        {
+            failed.push_back(item.first);
+        }
+    }
+
+    for (ISocketWrapper* peer : failed)
+    {
+        RemovePeer(*peer);
+    }
+}
+
+void ChatServer::Send(Peer& peer, const ConstBuffer* buffers, size_t count)
+{
+    if (m_writer)
+    {
+        // Worker writes all the data of the peer, so it stays ordered
+        auto data = std::make_shared<std::string>();
+        for (size_t i = 0; i < count; ++i)
+        {
+            data->append(buffers[i].data, buffers[i].size);
+        }
+        PostWrite(peer, data);
+        return;
+    }
+
+    const bool wasEmpty = peer.output.IsEmpty();
+    peer.output.Push(buffers, count);
+    if (peer.output.IsPaused())
+    {
+        throw std::runtime_error("Peer doesn't read its output.");
+    }
+    if (wasEmpty && !peer.output.IsEmpty() && m_outputWatch)
+    {
+        m_outputWatch(*peer.socket, true);
+    }
+}
+
+void ChatServer::PostBroadcast(const Peer& sender, std::string_view message)
+{
+    // Message points into the sender's framer, so it is copied once for each framing and shared by all the writes
+    std::shared_ptr<std::string> frames[2];
+    for (auto& item : m_peers)
+    {
+        const Peer& receiver = *item.second;
+        if (&receiver == &sender || receiver.state != PeerState::Established)
+        {
+            continue;
+        }
+
+        const MessageFramer::Framing framing = receiver.framer.GetFraming();
+        std::shared_ptr<std::string>& frame = frames[static_cast<size_t>(framing)];
+        if (!frame)
+        {
+            frame = MakeFrame(framing, sender.nickname, message);
+        }
+        PostWrite(receiver, frame);
+    }
+}
+
+void ChatServer::PostWrite(const Peer& peer, const std::shared_ptr<std::string>& data)
+{
+    ISocketWrapperPtr socket = peer.socket;
+    m_writer->Post(peer.worker, [this, socket, data]()
+    {
+        try
+        {
+            socket->Write(*data);
+        }
+        catch (const std::exception&)
+        {
+            std::lock_guard<std::mutex> lock(m_failedMutex);
+            m_failed.push_back(socket);
+        }
+    });
+}
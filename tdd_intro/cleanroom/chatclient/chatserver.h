@@ -0,0 +1,119 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "isocketwrapper.h"
+#include "messageframer.h"
+#include "outboundqueue.h"
+#include "workstealingexecutor.h"
+
+/*
+ * Chat server for many peers, driven by the readiness events of their connections.
+ *
+ * Server doesn't wait for anything itself: the event loop passes accepted connections to AddPeer
+ * and calls OnReadable when the peer's connection has data, so one thread can serve all the peers.
+ *
+ * Each peer goes through the handshake first:
+ *   * peer writes it's nickname and ':HELLO!' string ("metizik:HELLO!")
+ *   * server responses with it's nickname and ':HELLO!' magic ("server:HELLO!")
+ *   * if server receives malformated message - it drops connection with this peer
+ *   * peer may ask for the length prefixed framing by ':HELLO!v2' ("metizik:HELLO!v2"), server confirms it
+ *     with ':HELLO!v2' ("server:HELLO!v2") and both sides use it after the handshake (see MessageFramer).
+ *     Peers sending the old ':HELLO!' keep the '\0' terminated messages.
+ *     Peer is dropped when its message with the nickname would be too long for the length prefixed framing
+ *     (see MessageFramer::s_maxMessageSize), whatever framings the receivers use.
+ * Then every message of the peer is sent to all other peers, prefixed with the sender's nickname
+ * ("metizik: Hello!").
+ *
+ * Writes don't wait for the peers either: the part of a message which the peer's socket doesn't take right away
+ * is queued (see OutboundQueue) and sent by OnWritable. The output watch handler tells the event loop when
+ * to call it, so a slow or stalled peer delays only itself. Peer whose queued output reaches maxQueuedOutput
+ * (the high watermark of its queue) is dropped, so a stalled reader can't take the memory without a limit.
+ * The default takes one message of the largest size (see MessageFramer::s_maxMessageSize) at once.
+ *
+ * When the executor is given, each peer is pinned to one of its workers instead, which writes all the messages
+ * to this peer (including the handshake response) with the blocking writes.
+ * Peers whose writes failed on the workers are dropped on the next call of the server.
+ * Executor must finish all the tasks (see WorkStealingExecutor::Wait) before the server is destroyed.
+*/
+
+class ChatServer
+{
+public:
+    enum class PeerState
+    {
+        AwaitingHello,
+        Established,
+        Closed
+    };
+
+    using PeerRemovedHandler = std::function<void(ISocketWrapper& peer)>;
+    using OutputWatchHandler = std::function<void(ISocketWrapper& peer, bool watch)>;
+
+    static const size_t s_defaultMaxQueuedOutput = MessageFramer::s_maxMessageSize + MessageFramer::s_maxPrefixSize + 1;
+
+    explicit ChatServer(const std::string& nickname, WorkStealingExecutor* writer = nullptr,
+                        size_t maxQueuedOutput = s_defaultMaxQueuedOutput);
+
+    // Handler is called right before the removed peer's connection is released,
+    // so the event loop can stop watching it.
+    void SetPeerRemovedHandler(PeerRemovedHandler handler);
+    // Handler is called with true when the peer has queued output, so the event loop starts watching
+    // its connection for writability, and with false when all of it is sent.
+    void SetOutputWatchHandler(OutputWatchHandler handler);
+
+    // Starts serving the accepted connection, the handshake is expected from it first.
+    void AddPeer(const ISocketWrapperPtr& peer);
+    // Receives the data available in the peer's connection and processes complete messages.
+    // Returns false when the peer is disconnected and removed from the server.
+    bool OnReadable(ISocketWrapper& peer);
+    // Sends the queued output as far as the peer's connection takes it.
+    // Returns false when the write fails and the peer is removed from the server.
+    bool OnWritable(ISocketWrapper& peer);
+    // Drops the connection with the peer.
+    void RemovePeer(ISocketWrapper& peer);
+    // Drops the peers whose writes failed on the executor's workers.
+    void RemoveFailedPeers();
+
+    // State of the peer, Closed if the peer is unknown.
+    PeerState GetPeerState(ISocketWrapper& peer) const;
+    size_t GetPeerCount() const;
+
+private:
+    struct Peer
+    {
+        Peer(const ISocketWrapperPtr& socket, size_t maxQueuedOutput);
+
+        ISocketWrapperPtr socket;
+        MessageFramer framer;
+        OutboundQueue output;
+        PeerState state;
+        std::string nickname;
+        size_t worker;
+    };
+
+    bool ProcessMessage(Peer& peer, std::string_view message);
+    bool ProcessHello(Peer& peer, std::string_view message);
+    void Broadcast(const Peer& sender, std::string_view message);
+    // Sends the buffers to the peer without waiting, or posts them to its worker.
+    // Throws if the peer's queued output reaches the limit.
+    void Send(Peer& peer, const ConstBuffer* buffers, size_t count);
+    void PostBroadcast(const Peer& sender, std::string_view message);
+    // Writes the data on the peer's worker, the peer is dropped later if the write fails
+    void PostWrite(const Peer& peer, const std::shared_ptr<std::string>& data);
+
+private:
+    std::string m_nickname;
+    PeerRemovedHandler m_peerRemoved;
+    OutputWatchHandler m_outputWatch;
+    std::unordered_map<ISocketWrapper*, std::unique_ptr<Peer>> m_peers;
+    WorkStealingExecutor* m_writer;
+    const size_t m_maxQueuedOutput;
+    size_t m_nextWorker;
+    std::mutex m_failedMutex;
+    std::vector<ISocketWrapperPtr> m_failed;
+};
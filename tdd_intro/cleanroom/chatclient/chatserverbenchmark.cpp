@@ -0,0 +1,92 @@
+// Load generator for ChatServer running on the real sockets over loopback.
+// It is disabled by default, run it with --gtest_also_run_disabled_tests.
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <thread>
+#include "chatserverloop.h"
+#include "messageframer.h"
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const char* s_address = "127.0.0.1";
+    const int16_t s_port = 4446;
+    // Each peer needs two descriptors in this process, raise `ulimit -n` for thousands of peers
+    const size_t s_peers = 256;
+    const size_t s_messages = 2000;
+
+    double Percentile(std::vector<Clock::duration>& samples, double percentile)
+    {
+        const size_t index = static_cast<size_t>(percentile * (samples.size() - 1));
+        std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+        return std::chrono::duration<double, std::micro>(samples[index]).count();
+    }
+}
+
+TEST(ChatServerBenchmark, DISABLED_BroadcastLatency)
+{
+    std::atomic<bool> stopped(false);
+    std::promise<void> listening;
+    std::thread serverThread([&stopped, &listening]()
+    {
+        EpollReactor reactor;
+        SocketWrapper listener;
+        listener.Bind(s_address, s_port);
+        listener.Listen();
+        ChatServer server("server");
+        ChatServerLoop loop(reactor, listener, server);
+        listening.set_value();
+
+        while (!stopped)
+        {
+            reactor.Poll(50);
+        }
+    });
+    listening.get_future().wait();
+
+    std::vector<std::unique_ptr<SocketWrapper>> clients;
+    std::vector<std::unique_ptr<MessageFramer>> framers;
+    for (size_t i = 0; i < s_peers; ++i)
+    {
+        clients.emplace_back(new SocketWrapper);
+        clients.back()->Connect(s_address, s_port);
+        clients.back()->Write(std::string("peer") + std::to_string(i) + std::string(":HELLO!\0", 8));
+        framers.emplace_back(new MessageFramer(*clients.back()));
+
+        std::string_view hello;
+        ASSERT_TRUE(framers.back()->ReadMessage(hello));
+    }
+
+    std::vector<Clock::duration> firstDelivery;
+    std::vector<Clock::duration> allDelivered;
+    const std::string message("ping\0", 5);
+    for (size_t i = 0; i < s_messages; ++i)
+    {
+        auto sent = Clock::now();
+        clients[0]->Write(message);
+        for (size_t receiver = 1; receiver < s_peers; ++receiver)
+        {
+            std::string_view received;
+            ASSERT_TRUE(framers[receiver]->ReadMessage(received));
+            if (receiver == 1)
+            {
+                firstDelivery.push_back(Clock::now() - sent);
+            }
+        }
+        allDelivered.push_back(Clock::now() - sent);
+    }
+
+    stopped = true;
+    serverThread.join();
+
+    std::cout << "Peers: " << s_peers << ", messages: " << s_messages << std::endl;
+    std::cout << "First peer latency: p50 " << Percentile(firstDelivery, 0.5)
+              << " us, p99 " << Percentile(firstDelivery, 0.99) << " us" << std::endl;
+    std::cout << "All peers latency: p50 " << Percentile(allDelivered, 0.5)
+              << " us, p99 " << Percentile(allDelivered, 0.99) << " us" << std::endl;
+}
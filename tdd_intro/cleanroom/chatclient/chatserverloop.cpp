@@ -0,0 +1,62 @@
+#include <sys/epoll.h>
+#include <iostream>
+
+#include "chatserverloop.h"
+
+ChatServerLoop::ChatServerLoop(EpollReactor& reactor, SocketWrapper& listener, ChatServer& server)
+    : m_reactor(reactor)
+    , m_listener(listener)
+    , m_server(server)
+{
+    m_reactor.Register(m_listener.Handle(), EPOLLIN, [this](uint32_t) { OnAcceptable(); });
+    m_server.SetPeerRemovedHandler([this](ISocketWrapper& peer)
+    {
+        m_reactor.Unregister(static_cast<SocketWrapper&>(peer).Handle());
+    });
+    m_server.SetOutputWatchHandler([this](ISocketWrapper& peer, bool watch)
+    {
+        m_reactor.Modify(static_cast<SocketWrapper&>(peer).Handle(), watch ? EPOLLIN | EPOLLOUT : EPOLLIN);
+    });
+}
+
+ChatServerLoop::~ChatServerLoop()
+{
+    m_server.SetPeerRemovedHandler(ChatServer::PeerRemovedHandler());
+    m_server.SetOutputWatchHandler(ChatServer::OutputWatchHandler());
+    m_reactor.Unregister(m_listener.Handle());
+}
+
+void ChatServerLoop::OnAcceptable()
+{
+    std::shared_ptr<SocketWrapper> peer;
+    try
+    {
+        // Client may be gone already, then there is nothing to accept
+        peer = m_listener.TryAccept();
+    }
+    catch (const std::exception& error)
+    {
+        // Failure to accept one client (aborted connection, no free descriptors) must not stop the server
+        std::cerr << error.what();
+    }
+    if (!peer)
+    {
+        return;
+    }
+    m_server.AddPeer(peer);
+
+    // The handler keeps only a raw pointer: the server owns the peer and unregisters it on removal
+    SocketWrapper* socket = peer.get();
+    m_reactor.Register(peer->Handle(), EPOLLIN, [this, socket](uint32_t events)
+    {
+        // Failed write removes the peer, the socket must not be touched after that
+        if ((events & EPOLLOUT) && !m_server.OnWritable(*socket))
+        {
+            return;
+        }
+        if (events & ~EPOLLOUT)
+        {
+            m_server.OnReadable(*socket);
+        }
+    });
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include "chatserver.h"
+#include "epollreactor.h"
+#include "socketwrapper.h"
+
+/*
+ * Drives ChatServer with the readiness events of the real sockets (POSIX only).
+ *
+ * Listening socket and every accepted peer are registered in the given reactor,
+ * so the whole server runs on the thread calling reactor.Run().
+ * Connections are accepted without waiting, errors of accepting are written to std::cerr and the server goes on.
+ * The reactor must be different from the one used by sockets for their blocking waits
+ * (see SocketWrapper), otherwise a blocking Write would dispatch other peers recursively.
+*/
+
+class ChatServerLoop
+{
+public:
+    ChatServerLoop(EpollReactor& reactor, SocketWrapper& listener, ChatServer& server);
+    ~ChatServerLoop();
+    ChatServerLoop(const ChatServerLoop&) = delete;
+    ChatServerLoop& operator=(const ChatServerLoop&) = delete;
+
+private:
+    void OnAcceptable();
+
+private:
+    EpollReactor& m_reactor;
+    SocketWrapper& m_listener;
+    ChatServer& m_server;
+};
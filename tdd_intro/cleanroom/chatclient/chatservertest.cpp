@@ -0,0 +1,516 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include "chatserver.h"
+#include "mocks.h"
+
+using namespace testing;
+
+namespace
+{
+    // Action for Read(char*, size_t), which delivers the given data in one portion
+    std::function<size_t(char*, size_t)> Deliver(const std::string& data)
+    {
+        return [data](char* buffer, size_t size)
+        {
+            EXPECT_LE(data.size(), size);
+            std::memcpy(buffer, data.data(), data.size());
+            return data.size();
+        };
+    }
+
+    // Action for TryWriteV, which takes all the buffers and appends them to the given string
+    std::function<size_t(const ConstBuffer*, size_t)> Collect(std::string& written)
+    {
+        return [&written](const ConstBuffer* buffers, size_t count)
+        {
+            const size_t before = written.size();
+            for (size_t i = 0; i < count; ++i)
+            {
+                written.append(buffers[i].data, buffers[i].size);
+            }
+            return written.size() - before;
+        };
+    }
+
+    // Action for TryWriteV, which takes all the buffers
+    size_t TakeAll(const ConstBuffer* buffers, size_t count)
+    {
+        size_t taken = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            taken += buffers[i].size;
+        }
+        return taken;
+    }
+
+    const std::string s_clientHello("metizik:HELLO!\0", 15);
+    const std::string s_serverHello("server:HELLO!\0", 14);
+
+    // Sender stream with one message, which is too long to be length prefixed with the sender's nickname
+    std::string MakeOverlongStream()
+    {
+        std::string stream = s_clientHello;
+        stream.append(MessageFramer::s_maxMessageSize, 'a');
+        stream.push_back('\0');
+        return stream;
+    }
+}
+
+TEST(ChatServerTest, NewPeerAwaitsHello)
+{
+    auto peer = std::make_shared<SocketWrapperMock>();
+    ChatServer server("server");
+
+    server.AddPeer(peer);
+
+    EXPECT_EQ(ChatServer::PeerState::AwaitingHello, server.GetPeerState(*peer));
+}
+
+TEST(ChatServerTest, RespondsHelloToHello)
+{
+    auto peer = std::make_shared<SocketWrapperMock>();
+    ChatServer server("server");
+    server.AddPeer(peer);
+
+    std::string written;
+    EXPECT_CALL(*peer, Read(_, _)).WillOnce(Invoke(Deliver(s_clientHello)));
+    EXPECT_CALL(*peer, TryWriteV(_, _)).WillOnce(Invoke(Collect(written)));
+
+    EXPECT_TRUE(server.OnReadable(*peer));
+    EXPECT_EQ(s_serverHello, written);
+    EXPECT_EQ(ChatServer::PeerState::Established, server.GetPeerState(*peer));
+}
+
+TEST(ChatServerTest, ConfirmsLengthPrefixedFraming)
+{
+    auto peer = std::make_shared<SocketWrapperMock>();
+    ChatServer server("server");
+    server.AddPeer(peer);
+
+    std::string written;
+    EXPECT_CALL(*peer, Read(_, _)).WillOnce(Invoke(Deliver(std::string("metizik:HELLO!v2\0", 17))));
+    EXPECT_CALL(*peer, TryWriteV(_, _)).WillOnce(Invoke(Collect(written)));
+
+    EXPECT_TRUE(server.OnReadable(*peer));
+    EXPECT_EQ(std::string("server:HELLO!v2\0", 16), written);
+    EXPECT_EQ(ChatServer::PeerState::Established, server.GetPeerState(*peer));
+}
+
+TEST(ChatServerTest, WaitsForHelloSplitAcrossReads)
+{
+    auto peer = std::make_shared<SocketWrapperMock>();
+    ChatServer server("server");
+    server.AddPeer(peer);
+
+    EXPECT_CALL(*peer, Read(_, _)).WillOnce(Invoke(Deliver("metiz"))).WillOnce(Invoke(Deliver(s_clientHello.substr(5))));
+    EXPECT_CALL(*peer, TryWriteV(_, _)).WillOnce(Invoke(TakeAll));
+
+    EXPECT_TRUE(server.OnReadable(*peer));
+    EXPECT_EQ(ChatServer::PeerState::AwaitingHello, server.GetPeerState(*peer));
+    EXPECT_TRUE(server.OnReadable(*peer));
+    EXPECT_EQ(ChatServer::PeerState::Established, server.GetPeerState(*peer));
+}
+
+TEST(ChatServerTest, DropsPeerWithMalformatedHello)
+{
+    auto peer = std::make_shared<SocketWrapperMock>();
+    ChatServer server("server");
+    server.AddPeer(peer);
+
+    EXPECT_CALL(*peer, Read(_, _)).WillOnce(Invoke(Deliver(std::string("metizik:HI!\0", 12))));
+    EXPECT_CALL(*peer, TryWriteV(_, _)).Times(0);
+
+    EXPECT_FALSE(server.OnReadable(*peer));
+    EXPECT_EQ(ChatServer::PeerState::Closed, server.GetPeerState(*peer));
+    EXPECT_EQ(0u, server.GetPeerCount());
+}
+
+TEST(ChatServerTest, DropsPeerWithEmptyNickname)
+{
+    auto peer = std::make_shared<SocketWrapperMock>();
+    ChatServer server("server");
+    server.AddPeer(peer);
+
+    EXPECT_CALL(*peer, Read(_, _)).WillOnce(Invoke(Deliver(std::string(":HELLO!\0", 8))));
+
+    EXPECT_FALSE(server.OnReadable(*peer));
+    EXPECT_EQ(0u, server.GetPeerCount());
+}
+
+TEST(ChatServerTest, RemovesDisconnectedPeer)
+{
+    auto peer = std::make_shared<SocketWrapperMock>();
+    ChatServer server("server");
+    server.AddPeer(peer);
+    ISocketWrapper* removed = nullptr;
+    server.SetPeerRemovedHandler([&removed](ISocketWrapper& socket) { removed = &socket; });
+
+    EXPECT_CALL(*peer, Read(_, _)).WillOnce(Return(0));
+
+    EXPECT_FALSE(server.OnReadable(*peer));
+    EXPECT_EQ(peer.get(), removed);
+    EXPECT_EQ(0u, server.GetPeerCount());
+}
+
+TEST(ChatServerTest, RemovesPeerWhenReadFails)
+{
+    auto peer = std::make_shared<SocketWrapperMock>();
+    ChatServer server("server");
+    server.AddPeer(peer);
+
+    EXPECT_CALL(*peer, Read(_, _)).WillOnce(Throw(std::runtime_error("Failed to read data.")));
+
+    EXPECT_FALSE(server.OnReadable(*peer));
+    EXPECT_EQ(0u, server.GetPeerCount());
+}
+
+TEST(ChatServerTest, BroadcastsMessageToOtherEstablishedPeers)
+{
+    auto sender = std::make_shared<SocketWrapperMock>();
+    auto receiver = std::make_shared<SocketWrapperMock>();
+    auto newcomer = std::make_shared<SocketWrapperMock>();
+    ChatServer server("server");
+    server.AddPeer(sender);
+    server.AddPeer(receiver);
+    server.AddPeer(newcomer);
+
+    EXPECT_CALL(*sender, Read(_, _))
+            .WillOnce(Invoke(Deliver(s_clientHello)))
+            .WillOnce(Invoke(Deliver(std::string("Hello!\0", 7))));
+    EXPECT_CALL(*receiver, Read(_, _)).WillOnce(Invoke(Deliver(std::string("user:HELLO!\0", 12))));
+    EXPECT_CALL(*sender, TryWriteV(_, _)).WillOnce(Invoke(TakeAll));
+    std::string received;
+    EXPECT_CALL(*receiver, TryWriteV(_, _)).WillOnce(Invoke(TakeAll)).WillOnce(Invoke(Collect(received)));
+    EXPECT_CALL(*newcomer, TryWriteV(_, _)).Times(0); // handshake is not done yet
+
+    server.OnReadable(*sender);
+    server.OnReadable(*receiver);
+    server.OnReadable(*sender);
+
+    EXPECT_EQ(std::string("metizik: Hello!\0", 16), received);
+}
+
+TEST(ChatServerTest, ProcessesSeveralMessagesFromOneRead)
+{
+    auto sender = std::make_shared<SocketWrapperMock>();
+    auto receiver = std::make_shared<SocketWrapperMock>();
+    ChatServer server("server");
+    server.AddPeer(sender);
+    server.AddPeer(receiver);
+
+    EXPECT_CALL(*receiver, Read(_, _)).WillOnce(Invoke(Deliver(std::string("user:HELLO!\0", 12))));
+    EXPECT_CALL(*sender, Read(_, _)).WillOnce(Invoke(Deliver(s_clientHello + std::string("one\0two\0", 8))));
+    EXPECT_CALL(*sender, TryWriteV(_, _)).WillOnce(Invoke(TakeAll));
+    std::string received;
+    EXPECT_CALL(*receiver, TryWriteV(_, _)).WillRepeatedly(Invoke(Collect(received)));
+
+    server.OnReadable(*receiver);
+    server.OnReadable(*sender);
+
+    EXPECT_EQ(s_serverHello + std::string("metizik: one\0metizik: two\0", 26), received);
+}
+
+TEST(ChatServerTest, BroadcastsInFramingOfEachReceiver)
+{
+    auto sender = std::make_shared<SocketWrapperMock>();
+    auto oldReceiver = std::make_shared<SocketWrapperMock>();
+    auto newReceiver = std::make_shared<SocketWrapperMock>();
+    ChatServer server("server");
+    server.AddPeer(sender);
+    server.AddPeer(oldReceiver);
+    server.AddPeer(newReceiver);
+
+    // Message of the v2 sender may contain '\0'
+    EXPECT_CALL(*sender, Read(_, _)).WillOnce(Invoke(Deliver(std::string("metizik:HELLO!v2\0\x03" "a\0b", 21))));
+    EXPECT_CALL(*oldReceiver, Read(_, _)).WillOnce(Invoke(Deliver(std::string("old:HELLO!\0", 11))));
+    EXPECT_CALL(*newReceiver, Read(_, _)).WillOnce(Invoke(Deliver(std::string("new:HELLO!v2\0", 13))));
+    EXPECT_CALL(*sender, TryWriteV(_, _)).WillOnce(Invoke(TakeAll));
+    std::string oldReceived;
+    std::string newReceived;
+    EXPECT_CALL(*oldReceiver, TryWriteV(_, _)).WillOnce(Invoke(TakeAll)).WillOnce(Invoke(Collect(oldReceived)));
+    EXPECT_CALL(*newReceiver, TryWriteV(_, _)).WillOnce(Invoke(TakeAll)).WillOnce(Invoke(Collect(newReceived)));
+
+    server.OnReadable(*oldReceiver);
+    server.OnReadable(*newReceiver);
+    server.OnReadable(*sender);
+
+    EXPECT_EQ(std::string("metizik: a\0b\0", 13), oldReceived);
+    EXPECT_EQ(std::string("\x0cmetizik: a\0b", 13), newReceived);
+}
+
+TEST(ChatServerTest, DropsReceiverWhenWriteFails)
+{
+    auto sender = std::make_shared<SocketWrapperMock>();
+    auto receiver = std::make_shared<SocketWrapperMock>();
+    ChatServer server("server");
+    server.AddPeer(sender);
+    server.AddPeer(receiver);
+
+    EXPECT_CALL(*sender, Read(_, _))
+            .WillOnce(Invoke(Deliver(s_clientHello)))
+            .WillOnce(Invoke(Deliver(std::string("Hello!\0", 7))));
+    EXPECT_CALL(*receiver, Read(_, _)).WillOnce(Invoke(Deliver(std::string("user:HELLO!\0", 12))));
+    EXPECT_CALL(*sender, TryWriteV(_, _)).WillOnce(Invoke(TakeAll));
+    EXPECT_CALL(*receiver, TryWriteV(_, _)).WillOnce(Invoke(TakeAll)).WillOnce(Throw(std::runtime_error("Failed to send data.")));
+
+    server.OnReadable(*sender);
+    server.OnReadable(*receiver);
+
+    EXPECT_TRUE(server.OnReadable(*sender));
+    EXPECT_EQ(ChatServer::PeerState::Established, server.GetPeerState(*sender));
+    EXPECT_EQ(ChatServer::PeerState::Closed, server.GetPeerState(*receiver));
+}
+
+TEST(ChatServerTest, StalledPeerDoesNotDelayBroadcastToOthers)
+{
+    auto sender = std::make_shared<SocketWrapperMock>();
+    auto stalled = std::make_shared<SocketWrapperMock>();
+    auto receiver = std::make_shared<SocketWrapperMock>();
+    ChatServer server("server");
+    server.AddPeer(sender);
+    server.AddPeer(stalled);
+    server.AddPeer(receiver);
+    std::vector<std::pair<ISocketWrapper*, bool>> watches;
+    server.SetOutputWatchHandler([&watches](ISocketWrapper& peer, bool watch) { watches.emplace_back(&peer, watch); });
+
+    EXPECT_CALL(*sender, Read(_, _))
+            .WillOnce(Invoke(Deliver(s_clientHello)))
+            .WillOnce(Invoke(Deliver(std::string("Hello!\0", 7))));
+    EXPECT_CALL(*stalled, Read(_, _)).WillOnce(Invoke(Deliver(std::string("stalled:HELLO!\0", 15))));
+    EXPECT_CALL(*receiver, Read(_, _)).WillOnce(Invoke(Deliver(std::string("user:HELLO!\0", 12))));
+    EXPECT_CALL(*sender, TryWriteV(_, _)).WillOnce(Invoke(TakeAll));
+    EXPECT_CALL(*stalled, TryWriteV(_, _)).WillOnce(Invoke(TakeAll)).WillRepeatedly(Return(0));
+    EXPECT_CALL(*stalled, WriteV(_, _)).Times(0);
+    std::string received;
+    EXPECT_CALL(*receiver, TryWriteV(_, _)).WillOnce(Invoke(TakeAll)).WillOnce(Invoke(Collect(received)));
+
+    server.OnReadable(*sender);
+    server.OnReadable(*stalled);
+    server.OnReadable(*receiver);
+    EXPECT_TRUE(server.OnReadable(*sender));
+
+    EXPECT_EQ(std::string("metizik: Hello!\0", 16), received);
+    ASSERT_EQ(1u, watches.size());
+    EXPECT_EQ(stalled.get(), watches[0].first);
+    EXPECT_TRUE(watches[0].second);
+    EXPECT_TRUE(server.OnWritable(*stalled));
+    EXPECT_EQ(ChatServer::PeerState::Established, server.GetPeerState(*stalled));
+}
+
+TEST(ChatServerTest, DropsPeerWhenQueuedOutputReachesLimit)
+{
+    auto sender = std::make_shared<SocketWrapperMock>();
+    auto stalled = std::make_shared<SocketWrapperMock>();
+    auto receiver = std::make_shared<SocketWrapperMock>();
+    // Takes one "metizik: Hello!" frame, but not two of them
+    ChatServer server("server", nullptr, 32);
+    server.AddPeer(sender);
+    server.AddPeer(stalled);
+    server.AddPeer(receiver);
+
+    EXPECT_CALL(*sender, Read(_, _))
+            .WillOnce(Invoke(Deliver(s_clientHello)))
+            .WillOnce(Invoke(Deliver(std::string("Hello!\0", 7))))
+            .WillOnce(Invoke(Deliver(std::string("Hello!\0", 7))));
+    EXPECT_CALL(*stalled, Read(_, _)).WillOnce(Invoke(Deliver(std::string("stalled:HELLO!\0", 15))));
+    EXPECT_CALL(*receiver, Read(_, _)).WillOnce(Invoke(Deliver(std::string("user:HELLO!\0", 12))));
+    EXPECT_CALL(*sender, TryWriteV(_, _)).WillOnce(Invoke(TakeAll));
+    EXPECT_CALL(*stalled, TryWriteV(_, _)).WillOnce(Invoke(TakeAll)).WillRepeatedly(Return(0));
+    std::string received;
+    EXPECT_CALL(*receiver, TryWriteV(_, _)).WillOnce(Invoke(TakeAll)).WillRepeatedly(Invoke(Collect(received)));
+
+    server.OnReadable(*sender);
+    server.OnReadable(*stalled);
+    server.OnReadable(*receiver);
+    EXPECT_TRUE(server.OnReadable(*sender));
+    EXPECT_EQ(ChatServer::PeerState::Established, server.GetPeerState(*stalled));
+    EXPECT_TRUE(server.OnReadable(*sender));
+
+    EXPECT_EQ(ChatServer::PeerState::Closed, server.GetPeerState(*stalled));
+    EXPECT_EQ(ChatServer::PeerState::Established, server.GetPeerState(*sender));
+    EXPECT_EQ(std::string("metizik: Hello!\0metizik: Hello!\0", 32), received);
+}
+
+TEST(ChatServerTest, SendsQueuedOutputWhenPeerIsWritable)
+{
+    auto sender = std::make_shared<SocketWrapperMock>();
+    auto receiver = std::make_shared<SocketWrapperMock>();
+    ChatServer server("server");
+    server.AddPeer(sender);
+    server.AddPeer(receiver);
+    std::vector<bool> watches;
+    server.SetOutputWatchHandler([&watches](ISocketWrapper&, bool watch) { watches.push_back(watch); });
+
+    EXPECT_CALL(*sender, Read(_, _))
+            .WillOnce(Invoke(Deliver(s_clientHello)))
+            .WillOnce(Invoke(Deliver(std::string("Hello!\0", 7))));
+    EXPECT_CALL(*receiver, Read(_, _)).WillOnce(Invoke(Deliver(std::string("user:HELLO!\0", 12))));
+    EXPECT_CALL(*sender, TryWriteV(_, _)).WillOnce(Invoke(TakeAll));
+    std::string received;
+    EXPECT_CALL(*receiver, TryWriteV(_, _))
+            .WillOnce(Invoke(TakeAll))
+            .WillOnce(Return(9))
+            .WillOnce(Invoke(Collect(received)));
+
+    server.OnReadable(*sender);
+    server.OnReadable(*receiver);
+    server.OnReadable(*sender);
+    EXPECT_TRUE(server.OnWritable(*receiver));
+
+    EXPECT_EQ(std::string("Hello!\0", 7), received);
+    EXPECT_EQ(std::vector<bool>({ true, false }), watches);
+}
+
+TEST(ChatServerTest, DropsPeerWhenQueuedOutputFails)
+{
+    auto sender = std::make_shared<SocketWrapperMock>();
+    auto receiver = std::make_shared<SocketWrapperMock>();
+    ChatServer server("server");
+    server.AddPeer(sender);
+    server.AddPeer(receiver);
+
+    EXPECT_CALL(*sender, Read(_, _))
+            .WillOnce(Invoke(Deliver(s_clientHello)))
+            .WillOnce(Invoke(Deliver(std::string("Hello!\0", 7))));
+    EXPECT_CALL(*receiver, Read(_, _)).WillOnce(Invoke(Deliver(std::string("user:HELLO!\0", 12))));
+    EXPECT_CALL(*sender, TryWriteV(_, _)).WillOnce(Invoke(TakeAll));
+    EXPECT_CALL(*receiver, TryWriteV(_, _))
+            .WillOnce(Invoke(TakeAll))
+            .WillOnce(Return(0))
+            .WillOnce(Throw(std::runtime_error("Failed to send data.")));
+
+    server.OnReadable(*sender);
+    server.OnReadable(*receiver);
+    server.OnReadable(*sender);
+
+    EXPECT_FALSE(server.OnWritable(*receiver));
+    EXPECT_EQ(ChatServer::PeerState::Closed, server.GetPeerState(*receiver));
+}
+
+TEST(ChatServerTest, BroadcastsThroughExecutor)
+{
+    WorkStealingExecutor executor(2);
+    auto sender = std::make_shared<SocketWrapperMock>();
+    auto receiver = std::make_shared<SocketWrapperMock>();
+    ChatServer server("server", &executor);
+    server.AddPeer(sender);
+    server.AddPeer(receiver);
+
+    EXPECT_CALL(*sender, Read(_, _))
+            .WillOnce(Invoke(Deliver(s_clientHello)))
+            .WillOnce(Invoke(Deliver(std::string("Hello!\0", 7))));
+    EXPECT_CALL(*receiver, Read(_, _)).WillOnce(Invoke(Deliver(std::string("user:HELLO!\0", 12))));
+    EXPECT_CALL(*sender, Write(s_serverHello)).Times(1);
+    EXPECT_CALL(*receiver, Write(s_serverHello)).Times(1);
+    EXPECT_CALL(*receiver, Write(std::string("metizik: Hello!\0", 16))).Times(1);
+
+    server.OnReadable(*sender);
+    server.OnReadable(*receiver);
+    server.OnReadable(*sender);
+    executor.Wait();
+}
+
+TEST(ChatServerTest, BroadcastsThroughExecutorInFramingOfEachReceiver)
+{
+    WorkStealingExecutor executor(2);
+    auto sender = std::make_shared<SocketWrapperMock>();
+    auto oldReceiver = std::make_shared<SocketWrapperMock>();
+    auto newReceiver = std::make_shared<SocketWrapperMock>();
+    ChatServer server("server", &executor);
+    server.AddPeer(sender);
+    server.AddPeer(oldReceiver);
+    server.AddPeer(newReceiver);
+
+    EXPECT_CALL(*sender, Read(_, _))
+            .WillOnce(Invoke(Deliver(s_clientHello)))
+            .WillOnce(Invoke(Deliver(std::string("Hello!\0", 7))));
+    EXPECT_CALL(*oldReceiver, Read(_, _)).WillOnce(Invoke(Deliver(std::string("old:HELLO!\0", 11))));
+    EXPECT_CALL(*newReceiver, Read(_, _)).WillOnce(Invoke(Deliver(std::string("new:HELLO!v2\0", 13))));
+    EXPECT_CALL(*sender, Write(s_serverHello)).Times(1);
+    EXPECT_CALL(*oldReceiver, Write(s_serverHello)).Times(1);
+    EXPECT_CALL(*newReceiver, Write(std::string("server:HELLO!v2\0", 16))).Times(1);
+    EXPECT_CALL(*oldReceiver, Write(std::string("metizik: Hello!\0", 16))).Times(1);
+    EXPECT_CALL(*newReceiver, Write(std::string("\x0fmetizik: Hello!", 16))).Times(1);
+
+    server.OnReadable(*sender);
+    server.OnReadable(*oldReceiver);
+    server.OnReadable(*newReceiver);
+    server.OnReadable(*sender);
+    executor.Wait();
+}
+
+TEST(ChatServerTest, DropsReceiverWhenPostedWriteFails)
+{
+    WorkStealingExecutor executor(2);
+    auto sender = std::make_shared<SocketWrapperMock>();
+    auto receiver = std::make_shared<SocketWrapperMock>();
+    ChatServer server("server", &executor);
+    server.AddPeer(sender);
+    server.AddPeer(receiver);
+
+    EXPECT_CALL(*sender, Read(_, _))
+            .WillOnce(Invoke(Deliver(s_clientHello)))
+            .WillOnce(Invoke(Deliver(std::string("Hello!\0", 7))));
+    EXPECT_CALL(*receiver, Read(_, _)).WillOnce(Invoke(Deliver(std::string("user:HELLO!\0", 12))));
+    EXPECT_CALL(*sender, Write(s_serverHello)).Times(1);
+    EXPECT_CALL(*receiver, Write(s_serverHello)).Times(1);
+    EXPECT_CALL(*receiver, Write(std::string("metizik: Hello!\0", 16))).WillOnce(Throw(std::runtime_error("Failed to send data.")));
+
+    server.OnReadable(*sender);
+    server.OnReadable(*receiver);
+    server.OnReadable(*sender);
+    executor.Wait();
+    EXPECT_EQ(ChatServer::PeerState::Established, server.GetPeerState(*receiver));
+
+    server.RemoveFailedPeers();
+    EXPECT_EQ(ChatServer::PeerState::Closed, server.GetPeerState(*receiver));
+    EXPECT_EQ(ChatServer::PeerState::Established, server.GetPeerState(*sender));
+}
+
+TEST(ChatServerTest, DropsSenderOfOverlongMessage)
+{
+    auto sender = std::make_shared<SocketStreamFake>(MakeOverlongStream());
+    auto oldReceiver = std::make_shared<SocketStreamFake>(std::string("old:HELLO!\0", 11));
+    auto newReceiver = std::make_shared<SocketStreamFake>(std::string("new:HELLO!v2\0", 13));
+    ChatServer server("server");
+    server.AddPeer(oldReceiver);
+    server.AddPeer(newReceiver);
+    server.AddPeer(sender);
+    server.OnReadable(*oldReceiver);
+    server.OnReadable(*newReceiver);
+
+    while (server.OnReadable(*sender))
+    {
+    }
+
+    EXPECT_EQ(ChatServer::PeerState::Closed, server.GetPeerState(*sender));
+    EXPECT_EQ(ChatServer::PeerState::Established, server.GetPeerState(*oldReceiver));
+    EXPECT_EQ(ChatServer::PeerState::Established, server.GetPeerState(*newReceiver));
+    EXPECT_EQ(s_serverHello, oldReceiver->Written());
+    EXPECT_EQ(std::string("server:HELLO!v2\0", 16), newReceiver->Written());
+}
+
+TEST(ChatServerTest, DropsSenderOfOverlongMessageThroughExecutor)
+{
+    WorkStealingExecutor executor(2);
+    auto sender = std::make_shared<SocketStreamFake>(MakeOverlongStream());
+    auto oldReceiver = std::make_shared<SocketStreamFake>(std::string("old:HELLO!\0", 11));
+    auto newReceiver = std::make_shared<SocketStreamFake>(std::string("new:HELLO!v2\0", 13));
+    ChatServer server("server", &executor);
+    server.AddPeer(oldReceiver);
+    server.AddPeer(newReceiver);
+    server.AddPeer(sender);
+    server.OnReadable(*oldReceiver);
+    server.OnReadable(*newReceiver);
+
+    while (server.OnReadable(*sender))
+    {
+    }
+    executor.Wait();
+
+    EXPECT_EQ(ChatServer::PeerState::Closed, server.GetPeerState(*sender));
+    EXPECT_EQ(ChatServer::PeerState::Established, server.GetPeerState(*oldReceiver));
+    EXPECT_EQ(ChatServer::PeerState::Established, server.GetPeerState(*newReceiver));
+    EXPECT_EQ(s_serverHello, oldReceiver->Written());
+    EXPECT_EQ(std::string("server:HELLO!v2\0", 16), newReceiver->Written());
+}
@@ -0,0 +1,161 @@
+#pragma once
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+/*
+ * Coroutine returning a value of type T (or nothing for void).
+ *
+ * The coroutine doesn't run until it is awaited or started:
+ *   * co_await of the task from another coroutine runs it and resumes the awaiting one with the result
+ *     when it finishes, exception of the task is rethrown in the awaiting coroutine;
+ *   * top level task is run with Start(), it returns at the first suspension point
+ *     and the task is finished later by the scheduler, check it with IsDone().
+ * The task owns the coroutine frame, so it must outlive the run of the coroutine.
+*/
+
+template <typename T>
+class CoTask;
+
+template <typename T>
+class CoTaskPromiseBase
+{
+public:
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    auto final_suspend() noexcept
+    {
+        // Resumes the awaiting coroutine, if any, right from the finished one
+        struct FinalAwaiter
+        {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<typename CoTask<T>::promise_type> finished) noexcept
+            {
+                std::coroutine_handle<> continuation = finished.promise().m_continuation;
+                return continuation ? continuation : std::noop_coroutine();
+            }
+            void await_resume() noexcept { }
+        };
+        return FinalAwaiter();
+    }
+
+    void unhandled_exception() { m_exception = std::current_exception(); }
+
+    void SetContinuation(std::coroutine_handle<> continuation) { m_continuation = continuation; }
+
+protected:
+    void RethrowIfFailed()
+    {
+        if (m_exception)
+        {
+            std::rethrow_exception(m_exception);
+        }
+    }
+
+private:
+    std::coroutine_handle<> m_continuation;
+    std::exception_ptr m_exception;
+};
+
+template <typename T>
+class CoTaskPromise : public CoTaskPromiseBase<T>
+{
+public:
+    CoTask<T> get_return_object();
+    void return_value(T value) { m_value = std::move(value); }
+
+    T TakeResult()
+    {
+        this->RethrowIfFailed();
+        return std::move(*m_value);
+    }
+
+private:
+    std::optional<T> m_value;
+};
+
+template <>
+class CoTaskPromise<void> : public CoTaskPromiseBase<void>
+{
+public:
+    CoTask<void> get_return_object();
+    void return_void() { }
+
+    void TakeResult()
+    {
+        RethrowIfFailed();
+    }
+};
+
+template <typename T>
+class CoTask
+{
+public:
+    using promise_type = CoTaskPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    explicit CoTask(Handle coroutine) : m_coroutine(coroutine) { }
+    CoTask(CoTask&& other) noexcept : m_coroutine(std::exchange(other.m_coroutine, nullptr)) { }
+    CoTask(const CoTask&) = delete;
+    CoTask& operator=(const CoTask&) = delete;
+
+    ~CoTask()
+    {
+        if (m_coroutine)
+        {
+            m_coroutine.destroy();
+        }
+    }
+
+    // Runs the coroutine until its first suspension point.
+    void Start()
+    {
+        if (!m_coroutine.done())
+        {
+            m_coroutine.resume();
+        }
+    }
+
+    bool IsDone() const
+    {
+        return m_coroutine.done();
+    }
+
+    // Returns the result of the finished task or rethrows its exception. Can be taken once.
+    T Result()
+    {
+        return m_coroutine.promise().TakeResult();
+    }
+
+    auto operator co_await() noexcept
+    {
+        struct Awaiter
+        {
+            Handle coroutine;
+
+            bool await_ready() noexcept { return coroutine.done(); }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+            {
+                coroutine.promise().SetContinuation(awaiting);
+                return coroutine;
+            }
+            T await_resume() { return coroutine.promise().TakeResult(); }
+        };
+        return Awaiter{ m_coroutine };
+    }
+
+private:
+    Handle m_coroutine;
+};
+
+template <typename T>
+CoTask<T> CoTaskPromise<T>::get_return_object()
+{
+    return CoTask<T>(CoTask<T>::Handle::from_promise(*this));
+}
+
+inline CoTask<void> CoTaskPromise<void>::get_return_object()
+{
+    return CoTask<void>(CoTask<void>::Handle::from_promise(*this));
+}
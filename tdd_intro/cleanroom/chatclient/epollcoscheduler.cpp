@@ -0,0 +1,110 @@
+#include <sys/epoll.h>
+#include <stdexcept>
+
+#include "epollcoscheduler.h"
+#include "socketwrapper.h"
+
+EpollCoScheduler::EpollCoScheduler(EpollReactor& reactor)
+    : m_reactor(reactor)
+{
+}
+
+EpollCoScheduler::~EpollCoScheduler()
+{
+    // Suspended coroutines are owned by their tasks, they are just never resumed
+    for (const auto& item : m_waiters)
+    {
+        m_reactor.Unregister(item.first);
+    }
+}
+
+void EpollCoScheduler::ResumeWhenReadable(ISocketWrapper& socket, std::coroutine_handle<> coroutine)
+{
+    Wait(socket, coroutine, false);
+}
+
+void EpollCoScheduler::ResumeWhenWritable(ISocketWrapper& socket, std::coroutine_handle<> coroutine)
+{
+    Wait(socket, coroutine, true);
+}
+
+size_t EpollCoScheduler::GetWaitingCount() const
+{
+    size_t count = 0;
+    for (const auto& item : m_waiters)
+    {
+        count += (item.second.reader ? 1 : 0) + (item.second.writer ? 1 : 0);
+    }
+    return count;
+}
+
+void EpollCoScheduler::Wait(ISocketWrapper& socket, std::coroutine_handle<> coroutine, bool write)
+{
+    // Scheduler works only with the real sockets, which have the descriptor
+    const int fd = static_cast<SocketWrapper&>(socket).Handle();
+    auto found = m_waiters.find(fd);
+    if (found == m_waiters.end())
+    {
+        Waiters waiters;
+        (write ? waiters.writer : waiters.reader) = coroutine;
+        m_reactor.Register(fd, GetEvents(waiters), [this, fd](uint32_t events) { OnEvents(fd, events); });
+        m_waiters[fd] = waiters;
+        return;
+    }
+
+    std::coroutine_handle<>& waiter = write ? found->second.writer : found->second.reader;
+    if (waiter)
+    {
+        throw std::logic_error("Another coroutine is already waiting for the socket.");
+    }
+    waiter = coroutine;
+    m_reactor.Modify(fd, GetEvents(found->second));
+}
+
+void EpollCoScheduler::OnEvents(int fd, uint32_t events)
+{
+    auto found = m_waiters.find(fd);
+    if (found == m_waiters.end())
+    {
+        return;
+    }
+
+    // Errors and hang up are reported to both sides, the operation itself will fail then
+    const uint32_t failure = EPOLLERR | EPOLLHUP;
+    Waiters& waiters = found->second;
+    std::coroutine_handle<> reader;
+    std::coroutine_handle<> writer;
+    if (events & (EPOLLIN | EPOLLRDHUP | failure))
+    {
+        std::swap(reader, waiters.reader);
+    }
+    if (events & (EPOLLOUT | failure))
+    {
+        std::swap(writer, waiters.writer);
+    }
+
+    // Resumed coroutines may wait for this socket again, so the state is updated before
+    if (!waiters.reader && !waiters.writer)
+    {
+        m_waiters.erase(found);
+        m_reactor.Unregister(fd);
+    }
+    else
+    {
+        m_reactor.Modify(fd, GetEvents(waiters));
+    }
+
+    if (reader)
+    {
+        reader.resume();
+    }
+    if (writer)
+    {
+        writer.resume();
+    }
+}
+
+uint32_t EpollCoScheduler::GetEvents(const Waiters& waiters)
+{
+    return (waiters.reader ? uint32_t(EPOLLIN | EPOLLRDHUP) : 0u) | (waiters.writer ? uint32_t(EPOLLOUT) : 0u);
+}
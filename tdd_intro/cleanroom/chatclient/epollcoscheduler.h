@@ -0,0 +1,43 @@
+#pragma once
+#include <unordered_map>
+#include "epollreactor.h"
+#include "icoscheduler.h"
+
+/*
+ * Scheduler resuming coroutines on the readiness events of EpollReactor (POSIX only).
+ *
+ * Sockets must be SocketWrapper instances. Coroutines are resumed from reactor.Poll(),
+ * so the whole program of coroutines runs on the thread polling the reactor.
+ * The reactor must be different from the one used by sockets for their blocking waits
+ * (see SocketWrapper), otherwise Write or Connect would resume other coroutines recursively.
+*/
+
+class EpollCoScheduler : public ICoScheduler
+{
+public:
+    explicit EpollCoScheduler(EpollReactor& reactor);
+    ~EpollCoScheduler();
+    EpollCoScheduler(const EpollCoScheduler&) = delete;
+    EpollCoScheduler& operator=(const EpollCoScheduler&) = delete;
+
+    void ResumeWhenReadable(ISocketWrapper& socket, std::coroutine_handle<> coroutine) override;
+    void ResumeWhenWritable(ISocketWrapper& socket, std::coroutine_handle<> coroutine) override;
+
+    // Number of coroutines waiting for the sockets.
+    size_t GetWaitingCount() const;
+
+private:
+    struct Waiters
+    {
+        std::coroutine_handle<> reader;
+        std::coroutine_handle<> writer;
+    };
+
+    void Wait(ISocketWrapper& socket, std::coroutine_handle<> coroutine, bool write);
+    void OnEvents(int fd, uint32_t events);
+    static uint32_t GetEvents(const Waiters& waiters);
+
+private:
+    EpollReactor& m_reactor;
+    std::unordered_map<int, Waiters> m_waiters;
+};
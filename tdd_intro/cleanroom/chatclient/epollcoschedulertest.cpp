@@ -0,0 +1,71 @@
+// Tests of coroutines over the real sockets and EpollCoScheduler (POSIX only).
+#include <gtest/gtest.h>
+#include "chatcoroutines.h"
+#include "epollcoscheduler.h"
+#include "socketwrapper.h"
+
+namespace
+{
+    const char* s_address = "127.0.0.1";
+    const int16_t s_port = 4444;
+
+    CoTask<std::string> ServerHandshake(AsyncSocket& listener, ICoScheduler& scheduler, std::string& written)
+    {
+        AsyncSocket peer(co_await listener.Accept(), scheduler);
+        MessageFramer framer(peer.Socket());
+        std::string_view hello;
+        co_await ReadMessage(peer, framer, hello);
+        co_await peer.Write(std::string("server:HELLO!\0", 14));
+        written = std::string(hello);
+        co_return written;
+    }
+
+    CoTask<std::string> ConnectAndHandshake(AsyncSocket& client, MessageFramer& framer)
+    {
+        co_await client.Connect(s_address, s_port);
+        co_return co_await ClientHandshake(client, framer, "metizik");
+    }
+}
+
+TEST(EpollCoSchedulerTest, RunsHandshakeOfBothSidesOnOneThread)
+{
+    EpollReactor reactor;
+    EpollCoScheduler scheduler(reactor);
+    auto listenerSocket = std::make_shared<SocketWrapper>();
+    listenerSocket->Bind(s_address, s_port);
+    listenerSocket->Listen();
+    AsyncSocket listener(listenerSocket, scheduler);
+
+    std::string serverReceived;
+    auto server = ServerHandshake(listener, scheduler, serverReceived);
+    server.Start();
+
+    auto clientSocket = std::make_shared<SocketWrapper>();
+    AsyncSocket client(clientSocket, scheduler);
+    MessageFramer framer(*clientSocket);
+    auto handshake = ConnectAndHandshake(client, framer);
+    handshake.Start();
+
+    while (!handshake.IsDone() || !server.IsDone())
+    {
+        reactor.Poll(1000);
+    }
+
+    EXPECT_EQ("server", handshake.Result());
+    EXPECT_EQ("metizik:HELLO!", server.Result());
+    EXPECT_EQ(0u, scheduler.GetWaitingCount());
+}
+
+TEST(EpollCoSchedulerTest, ThrowsWhenSecondCoroutineWaitsForSameDirection)
+{
+    EpollReactor reactor;
+    EpollCoScheduler scheduler(reactor);
+    SocketWrapper socket;
+    socket.Bind(s_address, s_port);
+    socket.Listen();
+
+    std::coroutine_handle<> nothing = std::noop_coroutine();
+    scheduler.ResumeWhenReadable(socket, nothing);
+
+    EXPECT_THROW(scheduler.ResumeWhenReadable(socket, nothing), std::logic_error);
+}
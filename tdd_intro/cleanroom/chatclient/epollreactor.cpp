@@ -0,0 +1,108 @@
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "epollreactor.h"
+
+namespace
+{
+    const int s_maxEventsPerPoll = 64;
+
+    std::string GetExceptionString(const std::string& message, int errorCode)
+    {
+        return message + " " + std::to_string(errorCode) + " " + std::strerror(errorCode) + "\n";
+    }
+}
+
+EpollReactor::EpollReactor()
+    : m_epoll(epoll_create1(EPOLL_CLOEXEC))
+    , m_stopped(false)
+{
+    if (m_epoll == -1)
+    {
+        throw std::runtime_error(GetExceptionString("Failed to create epoll instance.", errno));
+    }
+}
+
+EpollReactor::~EpollReactor()
+{
+    close(m_epoll);
+}
+
+void EpollReactor::Register(int fd, uint32_t events, Handler handler)
+{
+    epoll_event event = {};
+    event.events = events;
+    event.data.fd = fd;
+    if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &event) == -1)
+    {
+        throw std::runtime_error(GetExceptionString("Failed to register descriptor.", errno));
+    }
+    m_handlers[fd] = std::move(handler);
+}
+
+void EpollReactor::Modify(int fd, uint32_t events)
+{
+    epoll_event event = {};
+    event.events = events;
+    event.data.fd = fd;
+    if (epoll_ctl(m_epoll, EPOLL_CTL_MOD, fd, &event) == -1)
+    {
+        throw std::runtime_error(GetExceptionString("Failed to modify descriptor events.", errno));
+    }
+}
+
+void EpollReactor::Unregister(int fd)
+{
+    epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr); // Descriptor may be already closed, nothing to do with the error
+    m_handlers.erase(fd);
+}
+
+int EpollReactor::Poll(int timeoutMs)
+{
+    epoll_event events[s_maxEventsPerPoll];
+    int ready = epoll_wait(m_epoll, events, s_maxEventsPerPoll, timeoutMs);
+    if (ready == -1)
+    {
+        if (errno == EINTR)
+        {
+            return 0;
+        }
+        throw std::runtime_error(GetExceptionString("Failed to wait for events.", errno));
+    }
+
+    for (int i = 0; i < ready; ++i)
+    {
+        // Handler may unregister itself or other descriptors, so look it up for every event
+        auto handler = m_handlers.find(events[i].data.fd);
+        if (handler != m_handlers.end())
+        {
+            Handler call = handler->second;
+            call(events[i].events);
+        }
+    }
+    return ready;
+}
+
+void EpollReactor::Run()
+{
+    m_stopped = false;
+    while (!m_stopped)
+    {
+        Poll(-1);
+    }
+}
+
+void EpollReactor::Stop()
+{
+    m_stopped = true;
+}
+
+EpollReactor& EpollReactor::ThreadDefault()
+{
+    static thread_local EpollReactor reactor;
+    return reactor;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+/*
+ * Single-threaded readiness reactor built on Linux epoll.
+ *
+ * Any number of file descriptors can be registered with a handler, which is called
+ * from Poll() with the ready event mask (EPOLLIN, EPOLLOUT, EPOLLERR, ...).
+ * This allows one thread to serve many connections instead of blocking in recv per socket.
+ *
+ * All methods throw exceptions when errors occur.
+ * Reactor is not thread safe: register, unregister and poll from the same thread.
+*/
+
+class EpollReactor
+{
+public:
+    using Handler = std::function<void(uint32_t events)>;
+
+    EpollReactor();
+    ~EpollReactor();
+    EpollReactor(const EpollReactor&) = delete;
+    EpollReactor& operator=(const EpollReactor&) = delete;
+
+    // Starts watching given descriptor for the events, handler is called when any of them occurs.
+    // Descriptor must not be registered already.
+    void Register(int fd, uint32_t events, Handler handler);
+    // Changes the set of events watched for already registered descriptor.
+    void Modify(int fd, uint32_t events);
+    // Stops watching the descriptor. It is safe to call it from the handler.
+    void Unregister(int fd);
+    // Waits for the events up to timeoutMs milliseconds (-1 waits infinitely) and dispatches them.
+    // Returns number of dispatched events.
+    int Poll(int timeoutMs);
+    // Dispatches events until Stop is called.
+    void Run();
+    // Makes Run return after the current iteration.
+    void Stop();
+
+    // Reactor used by sockets created without an explicit one, separate for each thread.
+    static EpollReactor& ThreadDefault();
+
+private:
+    int m_epoll;
+    bool m_stopped;
+    std::unordered_map<int, Handler> m_handlers;
+};
@@ -0,0 +1,21 @@
+#pragma once
+#include <coroutine>
+#include "isocketwrapper.h"
+
+/*
+ * Resumes coroutines suspended on the socket readiness, see AsyncSocket.
+ *
+ * The coroutine is resumed once, on the thread running the scheduler.
+ * Only one coroutine can wait for each direction of the socket at a time.
+*/
+
+class ICoScheduler
+{
+public:
+    virtual ~ICoScheduler() {}
+
+    // Resumes the coroutine when the socket has data to read, incoming connection to accept or is closed.
+    virtual void ResumeWhenReadable(ISocketWrapper& socket, std::coroutine_handle<> coroutine) = 0;
+    // Resumes the coroutine when data can be written to the socket.
+    virtual void ResumeWhenWritable(ISocketWrapper& socket, std::coroutine_handle<> coroutine) = 0;
+};
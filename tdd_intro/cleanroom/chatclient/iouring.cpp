@@ -0,0 +1,257 @@
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "iouring.h"
+
+namespace
+{
+    std::string GetExceptionString(const std::string& message, int errorCode)
+    {
+        return message + " " + std::to_string(errorCode) + " " + std::strerror(errorCode) + "\n";
+    }
+
+    int Setup(unsigned entries, io_uring_params& params)
+    {
+        return static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    }
+
+    void* MapRing(int ring, size_t size, off_t offset)
+    {
+        void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, offset);
+        if (mapped == MAP_FAILED)
+        {
+            throw std::runtime_error(GetExceptionString("Failed to map io_uring.", errno));
+        }
+        return mapped;
+    }
+
+    template <typename T>
+    T* At(void* ring, unsigned offset)
+    {
+        return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+    }
+
+    // Kernel reads the tail and writes the head of the submission queue, and the other way round for completions
+    unsigned LoadAcquire(const unsigned* position)
+    {
+        return __atomic_load_n(position, __ATOMIC_ACQUIRE);
+    }
+
+    void StoreRelease(unsigned* position, unsigned value)
+    {
+        __atomic_store_n(position, value, __ATOMIC_RELEASE);
+    }
+}
+
+IoUring::Operation::Operation()
+    : m_done(false)
+    , m_result(0)
+{
+}
+
+void IoUring::Operation::OnComplete(int result, uint32_t)
+{
+    m_done = true;
+    m_result = result;
+}
+
+bool IoUring::Operation::IsDone() const
+{
+    return m_done;
+}
+
+int IoUring::Operation::GetResult() const
+{
+    return m_result;
+}
+
+IoUring::IoUring(unsigned entries)
+    : m_sqRing(nullptr)
+    , m_cqRing(nullptr)
+    , m_sqes(nullptr)
+{
+    io_uring_params params = {};
+    m_ring = Setup(entries, params);
+    if (m_ring == -1)
+    {
+        throw std::runtime_error(GetExceptionString("Failed to create io_uring.", errno));
+    }
+
+    try
+    {
+        m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        if (params.features & IORING_FEAT_SINGLE_MMAP)
+        {
+            m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+        }
+        m_sqRing = MapRing(m_ring, m_sqRingSize, IORING_OFF_SQ_RING);
+        m_cqRing = (params.features & IORING_FEAT_SINGLE_MMAP) ? m_sqRing : MapRing(m_ring, m_cqRingSize, IORING_OFF_CQ_RING);
+        m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        m_sqes = static_cast<io_uring_sqe*>(MapRing(m_ring, m_sqesSize, IORING_OFF_SQES));
+    }
+    catch (...)
+    {
+        if (m_sqRing)
+        {
+            munmap(m_sqRing, m_sqRingSize);
+        }
+        close(m_ring);
+        throw;
+    }
+
+    m_sqHead = At<unsigned>(m_sqRing, params.sq_off.head);
+    m_sqTail = At<unsigned>(m_sqRing, params.sq_off.tail);
+    m_sqMask = *At<unsigned>(m_sqRing, params.sq_off.ring_mask);
+    m_sqEntries = params.sq_entries;
+    m_sqArray = At<unsigned>(m_sqRing, params.sq_off.array);
+    m_preparedTail = *m_sqTail;
+
+    m_cqHead = At<unsigned>(m_cqRing, params.cq_off.head);
+    m_cqTail = At<unsigned>(m_cqRing, params.cq_off.tail);
+    m_cqMask = *At<unsigned>(m_cqRing, params.cq_off.ring_mask);
+    m_cqes = At<io_uring_cqe>(m_cqRing, params.cq_off.cqes);
+
+    // Without the registered pool reads just go to the caller's memory
+    m_pool.resize(s_poolBuffers * s_poolBufferSize);
+    for (unsigned i = 0; i < s_poolBuffers; ++i)
+    {
+        m_poolBuffers.push_back(iovec{ m_pool.data() + i * s_poolBufferSize, s_poolBufferSize });
+    }
+    if (syscall(__NR_io_uring_register, m_ring, IORING_REGISTER_BUFFERS, m_poolBuffers.data(), s_poolBuffers) == 0)
+    {
+        for (int i = s_poolBuffers - 1; i >= 0; --i)
+        {
+            m_freeBuffers.push_back(i);
+        }
+    }
+}
+
+IoUring::~IoUring()
+{
+    munmap(m_sqes, m_sqesSize);
+    if (m_cqRing != m_sqRing)
+    {
+        munmap(m_cqRing, m_cqRingSize);
+    }
+    munmap(m_sqRing, m_sqRingSize);
+    close(m_ring);
+}
+
+bool IoUring::IsSupported()
+{
+    io_uring_params params = {};
+    int ring = Setup(1, params);
+    if (ring == -1)
+    {
+        return false;
+    }
+    close(ring);
+    return true;
+}
+
+io_uring_sqe& IoUring::Prepare(Completion& completion)
+{
+    if (m_preparedTail - LoadAcquire(m_sqHead) == m_sqEntries)
+    {
+        Submit();
+    }
+
+    const unsigned index = m_preparedTail & m_sqMask;
+    io_uring_sqe& entry = m_sqes[index];
+    std::memset(&entry, 0, sizeof(entry));
+    entry.user_data = reinterpret_cast<uint64_t>(&completion);
+    m_sqArray[index] = index;
+    ++m_preparedTail;
+    return entry;
+}
+
+void IoUring::Submit()
+{
+    Enter(0);
+}
+
+void IoUring::Wait(const Operation& operation)
+{
+    while (!operation.IsDone())
+    {
+        WaitAny();
+    }
+}
+
+void IoUring::WaitAny()
+{
+    Enter(1);
+    Dispatch();
+}
+
+int IoUring::AcquireBuffer()
+{
+    if (m_freeBuffers.empty())
+    {
+        return -1;
+    }
+    int index = m_freeBuffers.back();
+    m_freeBuffers.pop_back();
+    return index;
+}
+
+void IoUring::ReleaseBuffer(int index)
+{
+    m_freeBuffers.push_back(index);
+}
+
+char* IoUring::GetBuffer(int index)
+{
+    return static_cast<char*>(m_poolBuffers[index].iov_base);
+}
+
+IoUring& IoUring::ThreadDefault()
+{
+    static thread_local IoUring ring;
+    return ring;
+}
+
+void IoUring::Enter(unsigned waitFor)
+{
+    const unsigned toSubmit = m_preparedTail - *m_sqTail;
+    StoreRelease(m_sqTail, m_preparedTail);
+    if (toSubmit == 0 && waitFor == 0)
+    {
+        return;
+    }
+    // Completions may be already there, no need to wait for them in the kernel
+    if (toSubmit == 0 && LoadAcquire(m_cqTail) != *m_cqHead)
+    {
+        return;
+    }
+
+    const unsigned flags = waitFor ? IORING_ENTER_GETEVENTS : 0;
+    while (syscall(__NR_io_uring_enter, m_ring, toSubmit, waitFor, flags, nullptr, 0) == -1)
+    {
+        if (errno != EINTR)
+        {
+            throw std::runtime_error(GetExceptionString("Failed to submit io_uring operations.", errno));
+        }
+    }
+}
+
+void IoUring::Dispatch()
+{
+    // Head is reread every time, since the handler may prepare and wait for other operations
+    for (unsigned head = *m_cqHead; head != LoadAcquire(m_cqTail); head = *m_cqHead)
+    {
+        const io_uring_cqe entry = m_cqes[head & m_cqMask];
+        StoreRelease(m_cqHead, head + 1);
+        if (entry.user_data)
+        {
+            reinterpret_cast<Completion*>(entry.user_data)->OnComplete(entry.res, entry.flags);
+        }
+    }
+}
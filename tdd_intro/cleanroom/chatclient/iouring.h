@@ -0,0 +1,105 @@
+#pragma once
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Minimal Linux io_uring submission/completion ring, used without liburing.
+ *
+ * Operations are prepared into the submission queue without any system call.
+ * All the prepared ones are submitted by a single io_uring_enter, which also waits for the completions,
+ * so a blocking operation costs one system call instead of a readiness wait plus the operation itself.
+ *
+ * Ring owns a pool of buffers registered in the kernel once, for the fixed-buffer reads.
+ *
+ * All methods throw exceptions when errors occur.
+ * Ring is not thread safe: prepare, submit and wait from the same thread.
+*/
+
+class IoUring
+{
+public:
+    // Receives the results of the operation. Multishot operations complete many times,
+    // IORING_CQE_F_MORE is set in flags while more results follow.
+    class Completion
+    {
+    public:
+        virtual ~Completion() {}
+        virtual void OnComplete(int result, uint32_t flags) = 0;
+    };
+
+    // Completion of a single-shot operation, to wait for it with Wait.
+    class Operation : public Completion
+    {
+    public:
+        Operation();
+        void OnComplete(int result, uint32_t flags) override;
+        bool IsDone() const;
+        // Result of the system call, negative error code on failure.
+        int GetResult() const;
+
+    private:
+        bool m_done;
+        int m_result;
+    };
+
+    static const unsigned s_defaultEntries = 256;
+    static const unsigned s_poolBuffers = 16;
+    static const size_t s_poolBufferSize = 64 * 1024;
+
+    explicit IoUring(unsigned entries = s_defaultEntries);
+    ~IoUring();
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    // Checks whether the kernel allows to create a ring.
+    static bool IsSupported();
+
+    // Returns zeroed submission entry for the operation, completion must live until it completes.
+    // Submits already prepared entries, if the queue is full.
+    io_uring_sqe& Prepare(Completion& completion);
+    // Submits prepared entries without waiting.
+    void Submit();
+    // Submits prepared entries and dispatches completions until the operation is done.
+    void Wait(const Operation& operation);
+    // Submits prepared entries, waits for at least one completion and dispatches all the available ones.
+    void WaitAny();
+
+    // Takes a free registered buffer, returns its index or -1 if all of them are taken.
+    int AcquireBuffer();
+    void ReleaseBuffer(int index);
+    char* GetBuffer(int index);
+
+    // Ring used by sockets created without an explicit one, separate for each thread.
+    static IoUring& ThreadDefault();
+
+private:
+    void Enter(unsigned waitFor);
+    void Dispatch();
+
+private:
+    int m_ring;
+    void* m_sqRing;
+    size_t m_sqRingSize;
+    void* m_cqRing;
+    size_t m_cqRingSize;
+    io_uring_sqe* m_sqes;
+    size_t m_sqesSize;
+
+    unsigned* m_sqHead;
+    unsigned* m_sqTail;
+    unsigned m_sqMask;
+    unsigned m_sqEntries;
+    unsigned* m_sqArray;
+    unsigned m_preparedTail; // Tail including prepared, but not yet published entries
+
+    unsigned* m_cqHead;
+    unsigned* m_cqTail;
+    unsigned m_cqMask;
+    io_uring_cqe* m_cqes;
+
+    std::vector<char> m_pool;
+    std::vector<iovec> m_poolBuffers;
+    std::vector<int> m_freeBuffers;
+};
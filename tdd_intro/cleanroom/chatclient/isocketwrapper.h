@@ -6,6 +6,13 @@
 class ISocketWrapper;
 using ISocketWrapperPtr = std::shared_ptr<ISocketWrapper>;
 
+// Non-owning view of the memory to be written with ISocketWrapper::WriteV.
+struct ConstBuffer
+{
+    const char* data;
+    size_t size;
+};
+
 /*
  *  Wrapper around the standard SOCKET object.
  *
@@ -29,10 +36,25 @@ public:
     virtual ISocketWrapperPtr Accept() = 0;
     // Connects the socket to the binded port on specified address.
     virtual ISocketWrapperPtr Connect(const std::string& addr, int16_t port)= 0;
+    // Starts connecting like Connect, without waiting for the connection to be established.
+    // Returns the connected socket if it is established right away, nullptr if it is in progress:
+    // then wait until this socket is writable and call FinishConnect.
+    virtual ISocketWrapperPtr TryConnect(const std::string& addr, int16_t port) = 0;
+    // Completes the connection started by TryConnect, throws if it has failed.
+    virtual ISocketWrapperPtr FinishConnect() = 0;
     // Reads all available data from the stream of established connection.
     virtual void Read(std::string& buffer)= 0;
+    // Reads available data of established connection directly into the given memory, up to size bytes.
+    // Returns number of bytes read, 0 means that the connection is closed by the other side.
+    virtual size_t Read(char* buffer, size_t size) = 0;
     // Writes data to the stream of established connection.
     // Note, that this function succeeds when write operation is done:
     // it doesn't check whether the data was successfully received on the other side.
     virtual void Write(const std::string& buffer)= 0;
+    // Writes given buffers one after another as a single piece of data, gathering them
+    // in as few system calls as possible. Succeeds in the same way as Write.
+    virtual void WriteV(const ConstBuffer* buffers, size_t count) = 0;
+    // Writes as much of the given buffers as the socket accepts right now, without waiting.
+    // Returns number of bytes written, 0 if the socket can't take anything at the moment.
+    virtual size_t TryWriteV(const ConstBuffer* buffers, size_t count) = 0;
 };
@@ -0,0 +1,29 @@
+#pragma once
+#include <chrono>
+
+/*
+ * Time abstractions of the timer kata (demo/04_timer), so the code depending on time
+ * can be tested with the fake time instead of waiting.
+*/
+
+typedef std::chrono::high_resolution_clock Clock;
+typedef Clock::duration Duration;
+typedef std::chrono::time_point<Clock> TimePoint;
+
+class ITime
+{
+public:
+    virtual ~ITime() { }
+
+    virtual TimePoint GetCurrent() = 0;
+};
+
+class ITimer
+{
+public:
+    virtual ~ITimer() { }
+
+    virtual void Start() = 0;
+    virtual bool IsExpired() const = 0;
+    virtual Duration TimeLeft() const = 0;
+};
@@ -0,0 +1,251 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+#include "latencyrecorder.h"
+
+namespace
+{
+    const unsigned s_linearBits = 5; // Values below 2^5 have a bucket each
+    const uint64_t s_subBuckets = uint64_t(1) << (s_linearBits - 1);
+
+    std::atomic<uint64_t> s_nextRecorderId(1);
+
+    // Histograms of the recorder the thread used last time
+    struct ThreadCache
+    {
+        uint64_t recorder = 0;
+        void* histograms = nullptr;
+    };
+    thread_local ThreadCache s_threadCache;
+
+    std::string FormatMicroseconds(uint64_t nanoseconds)
+    {
+        std::ostringstream stream;
+        stream << std::fixed << std::setprecision(1) << nanoseconds / 1000.0 << " us";
+        return stream.str();
+    }
+}
+
+const char* const InstrumentedGui::s_statsCommand = "!stats!";
+
+LatencyHistogram::LatencyHistogram()
+{
+    for (auto& count : m_counts)
+    {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+
+LatencyHistogram::LatencyHistogram(const LatencyHistogram& other)
+    : LatencyHistogram()
+{
+    Add(other);
+}
+
+void LatencyHistogram::Record(uint64_t nanoseconds)
+{
+    // The only writer, so the plain load and store are enough
+    std::atomic<uint64_t>& count = m_counts[GetBucket(nanoseconds)];
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::Add(const LatencyHistogram& other)
+{
+    for (size_t i = 0; i < s_bucketCount; ++i)
+    {
+        const uint64_t added = other.m_counts[i].load(std::memory_order_relaxed);
+        m_counts[i].store(m_counts[i].load(std::memory_order_relaxed) + added, std::memory_order_relaxed);
+    }
+}
+
+uint64_t LatencyHistogram::GetCount() const
+{
+    uint64_t total = 0;
+    for (const auto& count : m_counts)
+    {
+        total += count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t LatencyHistogram::GetPercentile(double share) const
+{
+    const uint64_t total = GetCount();
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(share * total)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < s_bucketCount; ++i)
+    {
+        seen += m_counts[i].load(std::memory_order_relaxed);
+        if (seen >= rank)
+        {
+            return GetBucketUpperBound(i);
+        }
+    }
+    return GetBucketUpperBound(s_bucketCount - 1);
+}
+
+size_t LatencyHistogram::GetBucket(uint64_t nanoseconds)
+{
+    if (nanoseconds < (uint64_t(1) << s_linearBits))
+    {
+        return static_cast<size_t>(nanoseconds);
+    }
+    nanoseconds = std::min(nanoseconds, s_maxValue - 1);
+
+    // Top s_linearBits bits of the value select the bucket within its power of two
+    const unsigned highestBit = static_cast<unsigned>(std::bit_width(nanoseconds)) - 1;
+    const unsigned shift = highestBit - s_linearBits + 1;
+    return static_cast<size_t>(s_subBuckets * shift + (nanoseconds >> shift));
+}
+
+uint64_t LatencyHistogram::GetBucketUpperBound(size_t bucket)
+{
+    if (bucket < (size_t(1) << s_linearBits))
+    {
+        return bucket;
+    }
+    const unsigned shift = static_cast<unsigned>(bucket / s_subBuckets - 1);
+    const uint64_t mantissa = bucket - s_subBuckets * shift;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+LatencyRecorder::Span::Span(LatencyRecorder* recorder, Stage stage)
+    : m_recorder(recorder)
+    , m_stage(stage)
+{
+    if (m_recorder)
+    {
+        m_start = m_recorder->m_time.GetCurrent();
+    }
+}
+
+LatencyRecorder::Span::~Span()
+{
+    if (m_recorder)
+    {
+        m_recorder->Record(m_stage, m_recorder->m_time.GetCurrent() - m_start);
+    }
+}
+
+void LatencyRecorder::Span::Cancel()
+{
+    m_recorder = nullptr;
+}
+
+LatencyRecorder::LatencyRecorder(ITime& time)
+    : m_time(time)
+    , m_id(s_nextRecorderId.fetch_add(1))
+{
+}
+
+void LatencyRecorder::Record(Stage stage, Duration duration)
+{
+    const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    GetThreadHistograms().stages[static_cast<size_t>(stage)].Record(nanoseconds > 0 ? static_cast<uint64_t>(nanoseconds) : 0);
+}
+
+LatencyHistogram LatencyRecorder::GetHistogram(Stage stage) const
+{
+    LatencyHistogram merged;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& thread : m_threads)
+    {
+        merged.Add(thread->stages[static_cast<size_t>(stage)]);
+    }
+    return merged;
+}
+
+std::vector<std::string> LatencyRecorder::Report() const
+{
+    std::vector<std::string> lines;
+    for (size_t i = 0; i < static_cast<size_t>(Stage::Count); ++i)
+    {
+        const Stage stage = static_cast<Stage>(i);
+        const LatencyHistogram histogram = GetHistogram(stage);
+        lines.push_back(std::string(GetStageName(stage)) + ": " + std::to_string(histogram.GetCount()) + " spans"
+                        + ", p50 " + FormatMicroseconds(histogram.GetPercentile(0.5))
+                        + ", p99 " + FormatMicroseconds(histogram.GetPercentile(0.99))
+                        + ", max " + FormatMicroseconds(histogram.GetPercentile(1.0)));
+    }
+    return lines;
+}
+
+const char* LatencyRecorder::GetStageName(Stage stage)
+{
+    switch (stage)
+    {
+    case Stage::Frame:
+        return "frame";
+    case Stage::Send:
+        return "send";
+    case Stage::Recv:
+        return "recv";
+    case Stage::Parse:
+        return "parse";
+    case Stage::Display:
+        return "display";
+    case Stage::Count:
+        break;
+    }
+    return "unknown";
+}
+
+LatencyRecorder::ThreadHistograms& LatencyRecorder::GetThreadHistograms()
+{
+    if (s_threadCache.recorder == m_id)
+    {
+        return *static_cast<ThreadHistograms*>(s_threadCache.histograms);
+    }
+
+    // Slow path, when the thread records into this recorder for the first time or after using another one
+    const std::thread::id current = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto found = std::find_if(m_threads.begin(), m_threads.end(),
+                              [current](const std::unique_ptr<ThreadHistograms>& thread) { return thread->thread == current; });
+    if (found == m_threads.end())
+    {
+        m_threads.emplace_back(new ThreadHistograms);
+        m_threads.back()->thread = current;
+        found = m_threads.end() - 1;
+    }
+    s_threadCache.recorder = m_id;
+    s_threadCache.histograms = found->get();
+    return **found;
+}
+
+InstrumentedGui::InstrumentedGui(IGui& gui, LatencyRecorder& recorder)
+    : m_gui(gui)
+    , m_recorder(recorder)
+{
+}
+
+std::string InstrumentedGui::Read()
+{
+    for (;;)
+    {
+        std::string line = m_gui.Read();
+        if (line != s_statsCommand)
+        {
+            return line;
+        }
+        for (const std::string& report : m_recorder.Report())
+        {
+            m_gui.Write(report);
+        }
+    }
+}
+
+void InstrumentedGui::Write(const std::string& text)
+{
+    LatencyRecorder::Span span(&m_recorder, LatencyRecorder::Stage::Display);
+    m_gui.Write(text);
+}
@@ -0,0 +1,135 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "igui.h"
+#include "itimer.h"
+
+/*
+ * Histogram of durations in nanoseconds with HDR-style log-linear buckets.
+ *
+ * Values below 32 ns get a bucket each, every next power of two is split into 16 buckets,
+ * so a bucket is at most ~6% wide. Values from s_maxValue on are counted in the last bucket.
+ *
+ * Record is called by one thread only, without locks or read-modify-write instructions.
+ * Any other thread may read the counters at the same time and gets a slightly stale picture.
+*/
+
+class LatencyHistogram
+{
+public:
+    static constexpr uint64_t s_maxValue = uint64_t(1) << 40; // ~18 minutes
+    static constexpr size_t s_bucketCount = 32 + 16 * 35; // Linear ones and 16 for each power of two up to s_maxValue
+
+    LatencyHistogram();
+    LatencyHistogram(const LatencyHistogram& other);
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void Record(uint64_t nanoseconds);
+    // Adds the counters of the other histogram to this one.
+    void Add(const LatencyHistogram& other);
+
+    uint64_t GetCount() const;
+    // Upper bound of the bucket, where the given share of the recorded values (0..1) is reached, 0 if empty.
+    uint64_t GetPercentile(double share) const;
+
+    static size_t GetBucket(uint64_t nanoseconds);
+    static uint64_t GetBucketUpperBound(size_t bucket);
+
+private:
+    std::array<std::atomic<uint64_t>, s_bucketCount> m_counts;
+};
+
+/*
+ * Latency instrumentation of the chat client.
+ *
+ * Each stage of a message (see Stage) is measured with a Span and recorded into the histogram
+ * of the calling thread, so the threads don't contend. Report merges the histograms of all threads.
+ * Time is taken from ITime, each span costs two GetCurrent calls and a histogram update.
+ * Recorder must outlive the spans and threads using it.
+*/
+
+class LatencyRecorder
+{
+public:
+    // Stages of a message after IGui::Read returned it, the wait for the user input is not measured
+    enum class Stage
+    {
+        Frame,   // Adding terminator or length prefix and batching
+        Send,    // Writing to the socket
+        Recv,    // Reading from the socket
+        Parse,   // Extracting the message from the received data
+        Display, // IGui::Write
+        Count
+    };
+
+    // Measures the time from its construction until its destruction. Does nothing if the recorder is null.
+    class Span
+    {
+    public:
+        Span(LatencyRecorder* recorder, Stage stage);
+        ~Span();
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+        // Drops the measurement, when the stage turned out to have nothing to do.
+        void Cancel();
+
+    private:
+        LatencyRecorder* m_recorder;
+        Stage m_stage;
+        TimePoint m_start;
+    };
+
+    explicit LatencyRecorder(ITime& time);
+
+    void Record(Stage stage, Duration duration);
+    // Merged histogram of the stage from all the threads.
+    LatencyHistogram GetHistogram(Stage stage) const;
+    // One line per stage: "send: 1024 spans, p50 1.5 us, p99 12.0 us, max 40.1 us".
+    std::vector<std::string> Report() const;
+
+    static const char* GetStageName(Stage stage);
+
+private:
+    struct ThreadHistograms
+    {
+        std::thread::id thread;
+        LatencyHistogram stages[static_cast<size_t>(Stage::Count)];
+    };
+
+    ThreadHistograms& GetThreadHistograms();
+
+private:
+    ITime& m_time;
+    const uint64_t m_id; // Unique id, so the thread cache doesn't mistake a new recorder for a destroyed one
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<ThreadHistograms>> m_threads;
+};
+
+/*
+ * GUI decorator, which measures the Display stage and serves the statistics command.
+ *
+ * When the user types s_statsCommand, the report of the recorder is displayed instead of sending the line,
+ * and the next line is read.
+*/
+
+class InstrumentedGui : public IGui
+{
+public:
+    static const char* const s_statsCommand;
+
+    InstrumentedGui(IGui& gui, LatencyRecorder& recorder);
+
+    std::string Read() override;
+    void Write(const std::string& text) override;
+
+private:
+    IGui& m_gui;
+    LatencyRecorder& m_recorder;
+};
@@ -0,0 +1,101 @@
+// Overhead of LatencyRecorder: cost of one span with the system clock,
+// and throughput of the send and receive path with and without the recorder.
+// It is disabled by default, run it with --gtest_also_run_disabled_tests.
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include "latencyrecorder.h"
+#include "messageframer.h"
+#include "transmitbatcher.h"
+#include "timer.h"
+#include "mocks.h"
+
+namespace
+{
+    const size_t s_spans = 10000000;
+    const size_t s_messages = 2000000;
+
+    // Batches, "sends" and parses the messages, measuring every stage of them if the recorder is given.
+    // Returns messages per second.
+    double MeasurePipeline(LatencyRecorder* recorder)
+    {
+        SystemTime time;
+        Timer deadline(time, std::chrono::milliseconds(1));
+        SocketStreamFake sent("");
+        TransmitBatcher batcher(sent, deadline, 4096);
+        batcher.SetRecorder(recorder);
+
+        const std::string text = "metizik: message of a typical chat length";
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < s_messages; ++i)
+        {
+            batcher.Write(text);
+        }
+        batcher.Flush();
+
+        SocketStreamFake received(sent.Written(), std::vector<size_t>(sent.Written().size() / 4096 + 1, 4096));
+        MessageFramer framer(received);
+        size_t parsed = 0;
+        for (;;)
+        {
+            std::string_view message;
+            bool next;
+            {
+                LatencyRecorder::Span span(recorder, LatencyRecorder::Stage::Parse);
+                next = framer.NextMessage(message);
+                if (!next)
+                {
+                    span.Cancel();
+                }
+            }
+            if (next)
+            {
+                ++parsed;
+                continue;
+            }
+            LatencyRecorder::Span span(recorder, LatencyRecorder::Stage::Recv);
+            if (!framer.Receive())
+            {
+                break;
+            }
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        EXPECT_EQ(s_messages, parsed);
+        return s_messages / seconds;
+    }
+}
+
+TEST(LatencyRecorderBenchmark, DISABLED_SpanOverhead)
+{
+    SystemTime time;
+    LatencyRecorder recorder(time);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < s_spans; ++i)
+    {
+        LatencyRecorder::Span span(&recorder, LatencyRecorder::Stage::Parse);
+    }
+    const double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    const double perSpan = nanoseconds / s_spans;
+
+    std::cout << "Span: " << perSpan << " ns" << std::endl;
+    EXPECT_LT(perSpan, 200.0); // Two clock reads and a histogram update, far below a system call
+}
+
+TEST(LatencyRecorderBenchmark, DISABLED_PipelineWithAndWithoutRecorder)
+{
+    SystemTime time;
+    LatencyRecorder recorder(time);
+
+    const double plain = MeasurePipeline(nullptr);
+    const double measured = MeasurePipeline(&recorder);
+
+    std::cout << "Without recorder: " << plain << " messages/s" << std::endl;
+    std::cout << "With recorder: " << measured << " messages/s, "
+              << (1.0 / measured - 1.0 / plain) * 1e9 << " ns added per message" << std::endl;
+    for (const std::string& line : recorder.Report())
+    {
+        std::cout << "  " << line << std::endl;
+    }
+}
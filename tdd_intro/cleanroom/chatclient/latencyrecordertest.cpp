@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <random>
+#include <thread>
+#include "latencyrecorder.h"
+#include "timer.h"
+#include "mocks.h"
+
+using namespace testing;
+using namespace std::chrono_literals;
+
+TEST(LatencyHistogramTest, SmallValuesAreExact)
+{
+    for (uint64_t value = 0; value < 32; ++value)
+    {
+        EXPECT_EQ(value, LatencyHistogram::GetBucketUpperBound(LatencyHistogram::GetBucket(value)));
+    }
+}
+
+TEST(LatencyHistogramTest, BucketKeepsValueWithinSixPercent)
+{
+    std::mt19937_64 random(42);
+    for (int i = 0; i < 100000; ++i)
+    {
+        const uint64_t value = random() % LatencyHistogram::s_maxValue;
+        const size_t bucket = LatencyHistogram::GetBucket(value);
+        const uint64_t upper = LatencyHistogram::GetBucketUpperBound(bucket);
+
+        ASSERT_LT(bucket, LatencyHistogram::s_bucketCount);
+        ASSERT_LE(value, upper);
+        ASSERT_LE(upper - value, value / 16);
+    }
+}
+
+TEST(LatencyHistogramTest, ReturnsPercentiles)
+{
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 100; ++value)
+    {
+        histogram.Record(value * 1000);
+    }
+
+    EXPECT_EQ(100u, histogram.GetCount());
+    EXPECT_NEAR(50000.0, histogram.GetPercentile(0.5), 50000.0 / 16);
+    EXPECT_NEAR(99000.0, histogram.GetPercentile(0.99), 99000.0 / 16);
+    EXPECT_NEAR(100000.0, histogram.GetPercentile(1.0), 100000.0 / 16);
+    EXPECT_EQ(0u, LatencyHistogram().GetPercentile(0.5));
+}
+
+TEST(LatencyRecorderTest, SpanRecordsElapsedTime)
+{
+    TimeFake time;
+    LatencyRecorder recorder(time);
+
+    {
+        LatencyRecorder::Span span(&recorder, LatencyRecorder::Stage::Send);
+        time.Wait(2ms);
+    }
+
+    const LatencyHistogram histogram = recorder.GetHistogram(LatencyRecorder::Stage::Send);
+    EXPECT_EQ(1u, histogram.GetCount());
+    EXPECT_NEAR(2000000.0, histogram.GetPercentile(1.0), 2000000.0 / 16);
+    EXPECT_EQ(0u, recorder.GetHistogram(LatencyRecorder::Stage::Recv).GetCount());
+}
+
+TEST(LatencyRecorderTest, CancelledSpanRecordsNothing)
+{
+    TimeFake time;
+    LatencyRecorder recorder(time);
+
+    {
+        LatencyRecorder::Span span(&recorder, LatencyRecorder::Stage::Parse);
+        span.Cancel();
+    }
+
+    EXPECT_EQ(0u, recorder.GetHistogram(LatencyRecorder::Stage::Parse).GetCount());
+}
+
+TEST(LatencyRecorderTest, SpanWithoutRecorderDoesNothing)
+{
+    LatencyRecorder::Span span(nullptr, LatencyRecorder::Stage::Send);
+}
+
+TEST(LatencyRecorderTest, MergesHistogramsOfAllThreads)
+{
+    SystemTime time;
+    LatencyRecorder recorder(time);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&recorder]()
+        {
+            for (int j = 0; j < 1000; ++j)
+            {
+                recorder.Record(LatencyRecorder::Stage::Parse, 1us);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(4000u, recorder.GetHistogram(LatencyRecorder::Stage::Parse).GetCount());
+}
+
+TEST(LatencyRecorderTest, ReportsEveryStage)
+{
+    TimeFake time;
+    LatencyRecorder recorder(time);
+    recorder.Record(LatencyRecorder::Stage::Send, 1500ns);
+
+    const std::vector<std::string> report = recorder.Report();
+
+    ASSERT_EQ(5u, report.size());
+    EXPECT_EQ("frame: 0 spans, p50 0.0 us, p99 0.0 us, max 0.0 us", report[0]);
+    EXPECT_EQ("send: 1 spans, p50 1.5 us, p99 1.5 us, max 1.5 us", report[1]);
+}
+
+TEST(InstrumentedGuiTest, MeasuresDisplayButNotWaitForInput)
+{
+    GuiMock gui;
+    TimeFake time;
+    LatencyRecorder recorder(time);
+    InstrumentedGui instrumented(gui, recorder);
+
+    EXPECT_CALL(gui, Read()).WillOnce(Return("Hello!"));
+    EXPECT_CALL(gui, Write("metizik: Hi!"));
+
+    EXPECT_EQ("Hello!", instrumented.Read());
+    instrumented.Write("metizik: Hi!");
+
+    for (const std::string& line : recorder.Report())
+    {
+        EXPECT_THAT(line, AnyOf(StartsWith("display: 1 spans"), HasSubstr(": 0 spans")));
+    }
+}
+
+TEST(InstrumentedGuiTest, DisplaysStatisticsOnCommandInsteadOfReturningIt)
+{
+    GuiMock gui;
+    TimeFake time;
+    LatencyRecorder recorder(time);
+    InstrumentedGui instrumented(gui, recorder);
+
+    std::vector<std::string> displayed;
+    EXPECT_CALL(gui, Read()).WillOnce(Return(InstrumentedGui::s_statsCommand)).WillOnce(Return("Hello!"));
+    EXPECT_CALL(gui, Write(_)).WillRepeatedly(Invoke([&displayed](const std::string& text) { displayed.push_back(text); }));
+
+    EXPECT_EQ("Hello!", instrumented.Read());
+    ASSERT_EQ(5u, displayed.size());
+    EXPECT_THAT(displayed[0], StartsWith("frame: 0 spans"));
+}
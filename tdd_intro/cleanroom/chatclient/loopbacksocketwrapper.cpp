@@ -0,0 +1,324 @@
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include "loopbacksocketwrapper.h"
+#include "slaballocator.h"
+
+namespace
+{
+    const size_t s_readPortionSize = 1024; // 1KB
+
+    size_t RoundUpToPowerOfTwo(size_t value)
+    {
+        size_t result = 1;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    // Bytes of one direction of the connection, for one writer and one reader thread.
+    // Each side closes it when the last socket of its end is destroyed.
+    class ByteRing
+    {
+    public:
+        explicit ByteRing(size_t capacity)
+            : m_data(new char[capacity])
+            , m_capacity(capacity)
+            , m_mask(capacity - 1)
+            , m_head(0)
+            , m_tail(0)
+            , m_writerClosed(false)
+            , m_readerClosed(false)
+        { }
+
+        // Writer side. Returns number of bytes taken, 0 if the ring is full.
+        size_t TryWrite(const char* data, size_t size)
+        {
+            if (m_readerClosed.load(std::memory_order_acquire))
+            {
+                throw std::runtime_error("Failed to send data. Connection is closed by the other side.");
+            }
+            const size_t tail = m_tail.load(std::memory_order_relaxed);
+            const size_t portion = std::min(size, m_capacity - (tail - m_head.load(std::memory_order_acquire)));
+            Copy(data, tail, portion);
+            m_tail.store(tail + portion, std::memory_order_release);
+            return portion;
+        }
+
+        // Reader side. Returns number of bytes read, 0 if the ring is empty.
+        size_t TryRead(char* buffer, size_t size)
+        {
+            const size_t head = m_head.load(std::memory_order_relaxed);
+            const size_t portion = std::min(size, m_tail.load(std::memory_order_acquire) - head);
+            const size_t offset = head & m_mask;
+            const size_t first = std::min(portion, m_capacity - offset);
+            std::memcpy(buffer, m_data.get() + offset, first);
+            std::memcpy(buffer + first, m_data.get(), portion - first);
+            m_head.store(head + portion, std::memory_order_release);
+            return portion;
+        }
+
+        void CloseWriter() { m_writerClosed.store(true, std::memory_order_release); }
+        void CloseReader() { m_readerClosed.store(true, std::memory_order_release); }
+        bool IsWriterClosed() const { return m_writerClosed.load(std::memory_order_acquire); }
+
+    private:
+        void Copy(const char* data, size_t tail, size_t size)
+        {
+            const size_t offset = tail & m_mask;
+            const size_t first = std::min(size, m_capacity - offset);
+            std::memcpy(m_data.get() + offset, data, first);
+            std::memcpy(m_data.get(), data + first, size - first);
+        }
+
+    private:
+        std::unique_ptr<char[]> m_data; // Not zeroed, connections are created often
+        const size_t m_capacity;
+        const size_t m_mask;
+        alignas(64) std::atomic<size_t> m_head;
+        alignas(64) std::atomic<size_t> m_tail;
+        std::atomic<bool> m_writerClosed;
+        std::atomic<bool> m_readerClosed;
+    };
+
+    struct Pipe
+    {
+        explicit Pipe(size_t capacity) : toServer(capacity), toClient(capacity) { }
+
+        ByteRing toServer;
+        ByteRing toClient;
+    };
+}
+
+// One end of the connection, shared by the sockets of this end
+class LoopbackSocketWrapper::Endpoint
+{
+public:
+    Endpoint(const std::shared_ptr<Pipe>& pipe, ByteRing& in, ByteRing& out)
+        : m_pipe(pipe), m_in(in), m_out(out)
+    { }
+
+    ~Endpoint()
+    {
+        m_out.CloseWriter();
+        m_in.CloseReader();
+    }
+
+    ByteRing& In() { return m_in; }
+    ByteRing& Out() { return m_out; }
+
+private:
+    std::shared_ptr<Pipe> m_pipe;
+    ByteRing& m_in;
+    ByteRing& m_out;
+};
+
+LoopbackNetwork::Listener::Listener()
+    : listening(false)
+{
+}
+
+LoopbackNetwork::LoopbackNetwork(size_t ringCapacity)
+    : m_ringCapacity(RoundUpToPowerOfTwo(ringCapacity))
+{
+}
+
+LoopbackNetwork& LoopbackNetwork::Instance()
+{
+    static LoopbackNetwork* network = new LoopbackNetwork;
+    return *network;
+}
+
+std::string LoopbackNetwork::MakeKey(const std::string& addr, int16_t port)
+{
+    return addr + ":" + std::to_string(port);
+}
+
+LoopbackSocketWrapper::LoopbackSocketWrapper()
+    : LoopbackSocketWrapper(LoopbackNetwork::Instance())
+{
+}
+
+LoopbackSocketWrapper::LoopbackSocketWrapper(LoopbackNetwork& network)
+    : m_network(network)
+{
+}
+
+LoopbackSocketWrapper::LoopbackSocketWrapper(LoopbackNetwork& network, const std::shared_ptr<Endpoint>& endpoint)
+    : m_network(network)
+    , m_endpoint(endpoint)
+{
+}
+
+LoopbackSocketWrapper::~LoopbackSocketWrapper()
+{
+    if (!m_listener)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_network.m_mutex);
+    auto found = m_network.m_listeners.find(m_key);
+    if (found != m_network.m_listeners.end() && found->second == m_listener)
+    {
+        m_network.m_listeners.erase(found);
+    }
+}
+
+void LoopbackSocketWrapper::Bind(const std::string& addr, int16_t port)
+{
+    const std::string key = LoopbackNetwork::MakeKey(addr, port);
+    auto listener = std::make_shared<LoopbackNetwork::Listener>();
+
+    std::lock_guard<std::mutex> lock(m_network.m_mutex);
+    if (!m_network.m_listeners.emplace(key, listener).second)
+    {
+        throw std::runtime_error("Failed to bind socket to address. Address is already in use.");
+    }
+    m_key = key;
+    m_listener = listener;
+}
+
+void LoopbackSocketWrapper::Listen()
+{
+    if (!m_listener)
+    {
+        throw std::runtime_error("Failed to listen on socket. Socket is not bound.");
+    }
+    std::lock_guard<std::mutex> lock(m_listener->mutex);
+    m_listener->listening = true;
+}
+
+ISocketWrapperPtr LoopbackSocketWrapper::Accept()
+{
+    if (!m_listener)
+    {
+        throw std::runtime_error("Failed to connect to client. Socket is not listening.");
+    }
+
+    std::unique_lock<std::mutex> lock(m_listener->mutex);
+    m_listener->connected.wait(lock, [this]() { return !m_listener->backlog.empty(); });
+    ISocketWrapperPtr accepted = std::move(m_listener->backlog.front());
+    m_listener->backlog.pop_front();
+    return accepted;
+}
+
+ISocketWrapperPtr LoopbackSocketWrapper::Connect(const std::string& addr, int16_t port)
+{
+    std::shared_ptr<LoopbackNetwork::Listener> listener;
+    {
+        std::lock_guard<std::mutex> lock(m_network.m_mutex);
+        auto found = m_network.m_listeners.find(LoopbackNetwork::MakeKey(addr, port));
+        if (found != m_network.m_listeners.end())
+        {
+            listener = found->second;
+        }
+    }
+
+    if (!listener)
+    {
+        throw std::runtime_error("Failed to connect to server. Connection refused.");
+    }
+
+    auto pipe = std::make_shared<Pipe>(m_network.m_ringCapacity);
+    auto server = std::make_shared<Endpoint>(pipe, pipe->toServer, pipe->toClient);
+    {
+        std::lock_guard<std::mutex> lock(listener->mutex);
+        if (!listener->listening)
+        {
+            throw std::runtime_error("Failed to connect to server. Connection refused.");
+        }
+        listener->backlog.push_back(std::allocate_shared<LoopbackSocketWrapper>(SlabAllocator<LoopbackSocketWrapper>(), m_network, server));
+    }
+    listener->connected.notify_one();
+
+    // This socket is connected now, the returned one shares the same connection
+    m_endpoint = std::make_shared<Endpoint>(pipe, pipe->toClient, pipe->toServer);
+    return std::allocate_shared<LoopbackSocketWrapper>(SlabAllocator<LoopbackSocketWrapper>(), m_network, m_endpoint);
+}
+
+ISocketWrapperPtr LoopbackSocketWrapper::TryConnect(const std::string& addr, int16_t port)
+{
+    // Connect only puts the connection into the backlog, so it never waits
+    return Connect(addr, port);
+}
+
+ISocketWrapperPtr LoopbackSocketWrapper::FinishConnect()
+{
+    throw std::logic_error("Connection is never in progress for the loopback socket.");
+}
+
+void LoopbackSocketWrapper::Read(std::string& buffer)
+{
+    buffer.resize(s_readPortionSize); // Reuses capacity of the caller's buffer
+    buffer.resize(Read(&buffer[0], buffer.size()));
+}
+
+size_t LoopbackSocketWrapper::Read(char* buffer, size_t size)
+{
+    ByteRing& in = GetEndpoint().In();
+    for (;;)
+    {
+        // Closing is checked first, so the data written before it is not lost
+        const bool closed = in.IsWriterClosed();
+        const size_t portion = in.TryRead(buffer, size);
+        if (portion > 0 || closed || size == 0)
+        {
+            return portion;
+        }
+        std::this_thread::yield();
+    }
+}
+
+void LoopbackSocketWrapper::Write(const std::string& buffer)
+{
+    const ConstBuffer whole = { buffer.data(), buffer.size() };
+    WriteV(&whole, 1);
+}
+
+void LoopbackSocketWrapper::WriteV(const ConstBuffer* buffers, size_t count)
+{
+    ByteRing& out = GetEndpoint().Out();
+    for (size_t i = 0; i < count; ++i)
+    {
+        for (size_t dataSent = 0; dataSent < buffers[i].size;)
+        {
+            const size_t portion = out.TryWrite(buffers[i].data + dataSent, buffers[i].size - dataSent);
+            if (portion == 0)
+            {
+                std::this_thread::yield();
+            }
+            dataSent += portion;
+        }
+    }
+}
+
+size_t LoopbackSocketWrapper::TryWriteV(const ConstBuffer* buffers, size_t count)
+{
+    ByteRing& out = GetEndpoint().Out();
+    size_t written = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const size_t portion = out.TryWrite(buffers[i].data, buffers[i].size);
+        written += portion;
+        if (portion < buffers[i].size)
+        {
+            break;
+        }
+    }
+    return written;
+}
+
+LoopbackSocketWrapper::Endpoint& LoopbackSocketWrapper::GetEndpoint() const
+{
+    if (!m_endpoint)
+    {
+        throw std::runtime_error("Socket is not connected.");
+    }
+    return *m_endpoint;
+}
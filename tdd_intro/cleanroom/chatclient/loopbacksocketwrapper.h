@@ -0,0 +1,88 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "isocketwrapper.h"
+
+/*
+ * In-process ISocketWrapper, which never goes to the kernel, for fast integration tests and benchmarks.
+ *
+ * Listeners are registered by their address and port in LoopbackNetwork, Connect finds the listener there
+ * and puts the server end of the new connection into its backlog for Accept.
+ * Data of each direction goes through a lock-free ring of bytes, blocking Read and Write
+ * just yield while the ring is empty (or full).
+ *
+ * As with the POSIX sockets, Connect connects this socket and returns another one sharing the same connection.
+ * Connection is closed when all sockets of one end are destroyed: the other end reads the rest of the data
+ * and then 0, its writes throw std::runtime_error.
+ * One end of the connection may be read by one thread and written by another one at the same time,
+ * but not read (or written) by two threads at once.
+*/
+
+class LoopbackNetwork
+{
+public:
+    static const size_t s_defaultRingCapacity = 16 * 1024;
+
+    // Ring capacity is rounded up to the power of two.
+    explicit LoopbackNetwork(size_t ringCapacity = s_defaultRingCapacity);
+    LoopbackNetwork(const LoopbackNetwork&) = delete;
+    LoopbackNetwork& operator=(const LoopbackNetwork&) = delete;
+
+    // Network used by sockets created without an explicit one. It is never destroyed.
+    static LoopbackNetwork& Instance();
+
+private:
+    friend class LoopbackSocketWrapper;
+
+    struct Listener
+    {
+        Listener();
+
+        std::mutex mutex;
+        std::condition_variable connected;
+        bool listening;
+        std::deque<ISocketWrapperPtr> backlog;
+    };
+
+    static std::string MakeKey(const std::string& addr, int16_t port);
+
+private:
+    const size_t m_ringCapacity;
+    std::mutex m_mutex;
+    std::unordered_map<std::string, std::shared_ptr<Listener>> m_listeners;
+};
+
+class LoopbackSocketWrapper : public ISocketWrapper
+{
+public:
+    class Endpoint;
+
+    LoopbackSocketWrapper();
+    explicit LoopbackSocketWrapper(LoopbackNetwork& network);
+    LoopbackSocketWrapper(LoopbackNetwork& network, const std::shared_ptr<Endpoint>& endpoint);
+    ~LoopbackSocketWrapper();
+    void Bind(const std::string& addr, int16_t port);
+    void Listen();
+    ISocketWrapperPtr Accept();
+    ISocketWrapperPtr Connect(const std::string& addr, int16_t port);
+    ISocketWrapperPtr TryConnect(const std::string& addr, int16_t port);
+    ISocketWrapperPtr FinishConnect();
+    void Read(std::string& buffer);
+    size_t Read(char* buffer, size_t size);
+    void Write(const std::string& buffer);
+    void WriteV(const ConstBuffer* buffers, size_t count);
+    size_t TryWriteV(const ConstBuffer* buffers, size_t count);
+
+private:
+    Endpoint& GetEndpoint() const;
+
+private:
+    LoopbackNetwork& m_network;
+    std::string m_key;
+    std::shared_ptr<LoopbackNetwork::Listener> m_listener;
+    std::shared_ptr<Endpoint> m_endpoint;
+};
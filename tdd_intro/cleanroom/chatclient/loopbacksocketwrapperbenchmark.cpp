@@ -0,0 +1,96 @@
+// Chat handshakes and message round trips over LoopbackSocketWrapper, compared with the real loopback sockets.
+// It is disabled by default, run it with --gtest_also_run_disabled_tests.
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <functional>
+#include "loopbacksocketwrapper.h"
+#include "chatserver.h"
+#include "messageframer.h"
+#include "socketwrapper.h"
+
+namespace
+{
+    const char* s_address = "127.0.0.1";
+    const int16_t s_port = 4451;
+
+    using SocketFactory = std::function<ISocketWrapperPtr()>;
+
+    // Connect, accept and the whole handshake with ChatServer, returns handshakes per second
+    double MeasureHandshakes(const SocketFactory& create, size_t handshakes)
+    {
+        ISocketWrapperPtr listener = create();
+        listener->Bind(s_address, s_port);
+        listener->Listen();
+        ChatServer chat("server");
+        const std::string hello("metizik:HELLO!\0", 15);
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < handshakes; ++i)
+        {
+            ISocketWrapperPtr client = create();
+            ISocketWrapperPtr connection = client->Connect(s_address, s_port);
+            ISocketWrapperPtr peer = listener->Accept();
+            chat.AddPeer(peer);
+
+            connection->Write(hello);
+            chat.OnReadable(*peer);
+            MessageFramer framer(*connection);
+            std::string_view response;
+            EXPECT_TRUE(framer.ReadMessage(response));
+            chat.RemovePeer(*peer);
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return handshakes / seconds;
+    }
+
+    // Message goes to the server and its broadcast comes back to the other client, returns round trips per second
+    double MeasureRoundTrips(const SocketFactory& create, size_t roundTrips)
+    {
+        ISocketWrapperPtr listener = create();
+        listener->Bind(s_address, s_port);
+        listener->Listen();
+        ChatServer chat("server");
+
+        ISocketWrapperPtr connections[2];
+        ISocketWrapperPtr clients[2];
+        ISocketWrapperPtr peers[2];
+        std::unique_ptr<MessageFramer> framers[2];
+        for (size_t i = 0; i < 2; ++i)
+        {
+            clients[i] = create();
+            connections[i] = clients[i]->Connect(s_address, s_port);
+            peers[i] = listener->Accept();
+            chat.AddPeer(peers[i]);
+            framers[i].reset(new MessageFramer(*connections[i]));
+            connections[i]->Write("peer" + std::to_string(i) + std::string(":HELLO!\0", 8));
+            chat.OnReadable(*peers[i]);
+            std::string_view response;
+            framers[i]->ReadMessage(response);
+        }
+
+        const std::string message("Hello!\0", 7);
+        std::string_view received;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < roundTrips; ++i)
+        {
+            connections[0]->Write(message);
+            chat.OnReadable(*peers[0]);
+            EXPECT_TRUE(framers[1]->ReadMessage(received));
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return roundTrips / seconds;
+    }
+}
+
+TEST(LoopbackSocketWrapperBenchmark, DISABLED_HandshakesAndRoundTrips)
+{
+    LoopbackNetwork network;
+    SocketFactory loopback = [&network]() { return std::make_shared<LoopbackSocketWrapper>(network); };
+    SocketFactory real = []() { return std::make_shared<SocketWrapper>(); };
+
+    std::cout << "Loopback handshakes: " << MeasureHandshakes(loopback, 1000000) << " /s" << std::endl;
+    std::cout << "Socket handshakes: " << MeasureHandshakes(real, 10000) << " /s" << std::endl;
+    std::cout << "Loopback round trips: " << MeasureRoundTrips(loopback, 1000000) << " /s" << std::endl;
+    std::cout << "Socket round trips: " << MeasureRoundTrips(real, 100000) << " /s" << std::endl;
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "loopbacksocketwrapper.h"
+#include "chatserver.h"
+#include "messageframer.h"
+
+namespace
+{
+    const char* s_address = "127.0.0.1";
+    const int16_t s_port = 4444;
+}
+
+TEST(LoopbackSocketWrapperTest, EstablishConnection)
+{
+    LoopbackNetwork network;
+    LoopbackSocketWrapper listener(network);
+    LoopbackSocketWrapper client(network);
+
+    listener.Bind(s_address, s_port);
+    listener.Listen();
+    client.Connect(s_address, s_port);
+    auto server = listener.Accept();
+
+    server->Write("bla-bla-bla");
+    std::string str;
+    client.Read(str);
+
+    EXPECT_EQ("bla-bla-bla", str);
+}
+
+TEST(LoopbackSocketWrapperTest, WriteGathersBuffers)
+{
+    LoopbackNetwork network;
+    LoopbackSocketWrapper listener(network);
+    LoopbackSocketWrapper client(network);
+
+    listener.Bind(s_address, s_port);
+    listener.Listen();
+    auto connection = client.Connect(s_address, s_port);
+    auto server = listener.Accept();
+
+    const ConstBuffer buffers[] = { { "bla", 3 }, { "-", 1 }, { "bla", 3 } };
+    connection->WriteV(buffers, 3);
+    char buffer[64] = {};
+    size_t received = server->Read(buffer, sizeof(buffer));
+
+    EXPECT_EQ("bla-bla", std::string(buffer, received));
+}
+
+TEST(LoopbackSocketWrapperTest, RefusesConnectionWithoutListener)
+{
+    LoopbackNetwork network;
+    LoopbackSocketWrapper bound(network);
+    LoopbackSocketWrapper client(network);
+
+    EXPECT_THROW(client.Connect(s_address, s_port), std::runtime_error);
+    bound.Bind(s_address, s_port);
+    EXPECT_THROW(client.Connect(s_address, s_port), std::runtime_error);
+}
+
+TEST(LoopbackSocketWrapperTest, PortIsFreedWithListener)
+{
+    LoopbackNetwork network;
+    {
+        LoopbackSocketWrapper listener(network);
+        listener.Bind(s_address, s_port);
+        LoopbackSocketWrapper other(network);
+        EXPECT_THROW(other.Bind(s_address, s_port), std::runtime_error);
+    }
+    LoopbackSocketWrapper listener(network);
+    EXPECT_NO_THROW(listener.Bind(s_address, s_port));
+}
+
+TEST(LoopbackSocketWrapperTest, ReadsRestOfDataAndThenZeroWhenPeerCloses)
+{
+    LoopbackNetwork network;
+    LoopbackSocketWrapper listener(network);
+    listener.Bind(s_address, s_port);
+    listener.Listen();
+    auto client = std::make_shared<LoopbackSocketWrapper>(network);
+    client->Connect(s_address, s_port)->Write("Bye!");
+    auto server = listener.Accept();
+
+    client.reset();
+
+    char buffer[64];
+    EXPECT_EQ(4u, server->Read(buffer, sizeof(buffer)));
+    EXPECT_EQ(0u, server->Read(buffer, sizeof(buffer)));
+    EXPECT_THROW(server->Write("Hello?"), std::runtime_error);
+}
+
+TEST(LoopbackSocketWrapperTest, TryWriteStopsWhenPeerDoesNotRead)
+{
+    LoopbackNetwork network(1024);
+    LoopbackSocketWrapper listener(network);
+    LoopbackSocketWrapper client(network);
+
+    listener.Bind(s_address, s_port);
+    listener.Listen();
+    client.Connect(s_address, s_port);
+    auto server = listener.Accept();
+
+    const std::string chunk(700, 'x');
+    const ConstBuffer buffer = { chunk.data(), chunk.size() };
+
+    EXPECT_EQ(700u, server->TryWriteV(&buffer, 1));
+    EXPECT_EQ(324u, server->TryWriteV(&buffer, 1));
+    EXPECT_EQ(0u, server->TryWriteV(&buffer, 1));
+}
+
+TEST(LoopbackSocketWrapperTest, StreamsDataLargerThanRingBetweenThreads)
+{
+    LoopbackNetwork network(1024);
+    LoopbackSocketWrapper listener(network);
+    LoopbackSocketWrapper client(network);
+
+    listener.Bind(s_address, s_port);
+    listener.Listen();
+    auto connection = client.Connect(s_address, s_port);
+    auto server = listener.Accept();
+
+    std::string sent(1024 * 1024, '\0');
+    for (size_t i = 0; i < sent.size(); ++i)
+    {
+        sent[i] = static_cast<char>(i * 7);
+    }
+    std::thread writer([&sent, server]() { server->Write(sent); });
+
+    std::string received;
+    char buffer[777];
+    while (received.size() < sent.size())
+    {
+        received.append(buffer, connection->Read(buffer, sizeof(buffer)));
+    }
+    writer.join();
+
+    EXPECT_TRUE(sent == received);
+}
+
+TEST(LoopbackSocketWrapperTest, ChatHandshakeWithServer)
+{
+    LoopbackNetwork network;
+    LoopbackSocketWrapper listener(network);
+    LoopbackSocketWrapper client(network);
+    ChatServer chat("server");
+
+    listener.Bind(s_address, s_port);
+    listener.Listen();
+    auto connection = client.Connect(s_address, s_port);
+    auto peer = listener.Accept();
+    chat.AddPeer(peer);
+
+    connection->Write(std::string("metizik:HELLO!\0", 15));
+    EXPECT_TRUE(chat.OnReadable(*peer));
+
+    MessageFramer framer(*connection);
+    std::string_view response;
+    ASSERT_TRUE(framer.ReadMessage(response));
+    EXPECT_EQ("server:HELLO!", response);
+    EXPECT_EQ(ChatServer::PeerState::Established, chat.GetPeerState(*peer));
+}
@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include "messageframer.h"
+
+MessageFramer::MessageFramer(ISocketWrapper& socket, size_t capacity)
+    : m_socket(socket)
+    , m_framing(Framing::Terminated)
+    , m_buffer(capacity > 0 ? capacity : 1)
+    , m_begin(0)
+    , m_scanned(0)
+    , m_end(0)
+    , m_prefixSize(0)
+    , m_frameSize(0)
+{
+}
+
+void MessageFramer::SetFraming(Framing framing)
+{
+    m_framing = framing;
+    m_scanned = m_begin;
+    m_prefixSize = m_frameSize = 0;
+}
+
+MessageFramer::Framing MessageFramer::GetFraming() const
+{
+    return m_framing;
+}
+
+bool MessageFramer::ReadMessage(std::string_view& message)
+{
+    while (!NextMessage(message))
+    {
+        if (!Receive())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MessageFramer::NextMessage(std::string_view& message)
+{
+    return m_framing == Framing::Terminated ? NextTerminated(message) : NextLengthPrefixed(message);
+}
+
+bool MessageFramer::Receive()
+{
+    if (m_begin == m_end)
+    {
+        // Everything is consumed, start filling from the beginning
+        m_begin = m_scanned = m_end = 0;
+    }
+
+    // Room is needed for the whole frame if its size is known, or at least for one more byte
+    const size_t needed = std::max(m_frameSize, m_end - m_begin + 1);
+    if (m_begin + needed > m_buffer.size())
+    {
+        if (m_begin > 0)
+        {
+            // Moves the incomplete message to the front to free the space after it
+            std::memmove(m_buffer.data(), m_buffer.data() + m_begin, m_end - m_begin);
+            m_scanned -= m_begin;
+            m_end -= m_begin;
+            m_begin = 0;
+        }
+        if (needed > m_buffer.size())
+        {
+            // The message doesn't fit into the buffer, terminated one may take s_maxMessageSize and the terminator
+            m_buffer.resize(m_frameSize > 0 ? m_frameSize : std::min(m_buffer.size() * 2, s_maxMessageSize + 1));
+        }
+    }
+
+    const size_t received = m_socket.Read(m_buffer.data() + m_end, m_buffer.size() - m_end);
+    m_end += received;
+    return received > 0;
+}
+
+size_t MessageFramer::EncodeLength(size_t length, char (&prefix)[s_maxPrefixSize])
+{
+    if (length > s_maxMessageSize)
+    {
+        throw std::runtime_error("Message is too long to be framed.");
+    }
+
+    size_t size = 0;
+    for (; length >= 0x80; length >>= 7)
+    {
+        prefix[size++] = static_cast<char>(length | 0x80);
+    }
+    prefix[size++] = static_cast<char>(length);
+    return size;
+}
+
+bool MessageFramer::NextTerminated(std::string_view& message)
+{
+    const char* data = m_buffer.data();
+    const void* terminator = std::memchr(data + m_scanned, '\0', m_end - m_scanned);
+    if (!terminator)
+    {
+        if (m_end - m_begin > s_maxMessageSize)
+        {
+            throw std::runtime_error("Message is too long.");
+        }
+        m_scanned = m_end;
+        return false;
+    }
+
+    const size_t messageEnd = static_cast<const char*>(terminator) - data;
+    if (messageEnd - m_begin > s_maxMessageSize)
+    {
+        throw std::runtime_error("Message is too long.");
+    }
+    message = std::string_view(data + m_begin, messageEnd - m_begin);
+    m_begin = messageEnd + 1;
+    m_scanned = m_begin;
+    return true;
+}
+
+bool MessageFramer::NextLengthPrefixed(std::string_view& message)
+{
+    const char* data = m_buffer.data();
+    if (m_prefixSize == 0)
+    {
+        uint64_t length = 0;
+        size_t size = 0;
+        for (;;)
+        {
+            if (m_begin + size == m_end)
+            {
+                return false; // Prefix is not received completely yet
+            }
+            if (size == s_maxPrefixSize)
+            {
+                throw std::runtime_error("Malformated message length.");
+            }
+            const uint8_t byte = static_cast<uint8_t>(data[m_begin + size]);
+            length |= static_cast<uint64_t>(byte & 0x7f) << (7 * size);
+            ++size;
+            if (!(byte & 0x80))
+            {
+                break;
+            }
+        }
+        if (length > s_maxMessageSize)
+        {
+            throw std::runtime_error("Message is too long.");
+        }
+        m_prefixSize = size;
+        m_frameSize = size + static_cast<size_t>(length);
+    }
+
+    if (m_end - m_begin < m_frameSize)
+    {
+        return false;
+    }
+
+    message = std::string_view(data + m_begin + m_prefixSize, m_frameSize - m_prefixSize);
+    m_begin += m_frameSize;
+    m_scanned = m_begin;
+    m_prefixSize = m_frameSize = 0;
+    return true;
+}
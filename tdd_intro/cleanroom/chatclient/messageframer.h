@@ -0,0 +1,70 @@
+#pragma once
+#include <string_view>
+#include <vector>
+#include "isocketwrapper.h"
+
+/*
+ * Splits the stream of established connection into chat messages.
+ *
+ * Two framings are supported, chosen during the handshake (see ChatServer):
+ *   * Terminated: END of message is determined by '\0' byte, the original protocol;
+ *   * LengthPrefixed ("v2"): every message is preceded by its length as a varint (7 bits per byte,
+ *     lower bits first, high bit set while more bytes follow), so the message may contain any bytes.
+ * The framer starts with Terminated framing, which is used for the handshake itself.
+ *
+ * One Read may deliver a part of the message or several messages at once. Framer keeps the incomplete tail
+ * in its own buffer, which is reused between reads and grows only when a single message doesn't fit into it.
+ * With the length prefix the buffer grows right to the size of the message.
+ *
+ * Exceptions of ISocketWrapper are passed through. Malformated length prefix
+ * or a message longer than s_maxMessageSize throw std::runtime_error, in both framings:
+ * the terminated message throws as soon as that much data is received without the terminator.
+*/
+
+class MessageFramer
+{
+public:
+    enum class Framing
+    {
+        Terminated,
+        LengthPrefixed
+    };
+
+    static const size_t s_defaultCapacity = 4096;
+    static const size_t s_maxPrefixSize = 5;
+    static const size_t s_maxMessageSize = 64 * 1024 * 1024;
+
+    explicit MessageFramer(ISocketWrapper& socket, size_t capacity = s_defaultCapacity);
+
+    // Switches the framing of the messages following the ones already returned.
+    void SetFraming(Framing framing);
+    Framing GetFraming() const;
+
+    // Reads the next complete message, without the terminator or length prefix.
+    // The message points into the internal buffer and stays valid until the next call.
+    // Returns false when the connection is closed, incomplete message is dropped in this case.
+    bool ReadMessage(std::string_view& message);
+
+    // Non-blocking building blocks of ReadMessage, to be used when socket readiness is known.
+    // Extracts the next complete message from already received data, returns false if there is none.
+    bool NextMessage(std::string_view& message);
+    // Reads once from the socket into the buffer. Returns false when the connection is closed.
+    bool Receive();
+
+    // Writes the length prefix of LengthPrefixed framing, returns its size.
+    static size_t EncodeLength(size_t length, char (&prefix)[s_maxPrefixSize]);
+
+private:
+    bool NextTerminated(std::string_view& message);
+    bool NextLengthPrefixed(std::string_view& message);
+
+private:
+    ISocketWrapper& m_socket;
+    Framing m_framing;
+    std::vector<char> m_buffer;
+    size_t m_begin;      // Beginning of the first not returned message
+    size_t m_scanned;    // Data before this position has no terminator after m_begin
+    size_t m_end;        // End of the received data
+    size_t m_prefixSize; // Length prefix of the message at m_begin, 0 until it is complete
+    size_t m_frameSize;  // Prefix and message at m_begin, known when m_prefixSize is set
+};
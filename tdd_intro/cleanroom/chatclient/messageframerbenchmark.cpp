@@ -0,0 +1,95 @@
+// Benchmark for MessageFramer parsing, no network is involved.
+// It is disabled by default, run it with --gtest_also_run_disabled_tests.
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include "messageframer.h"
+#include "mocks.h"
+
+TEST(MessageFramerBenchmark, DISABLED_MessagesPerSecond)
+{
+    const size_t messagesInStream = 100000;
+    const int passes = 50;
+
+    std::string stream;
+    for (size_t i = 0; i < messagesInStream; ++i)
+    {
+        stream += "metizik: message number " + std::to_string(i);
+        stream += '\0';
+    }
+    // Network delivers the data by portions, which do not match the message boundaries
+    SocketStreamFake socket(stream, std::vector<size_t>(stream.size() / 1000 + 1, 1000));
+
+    size_t messages = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass)
+    {
+        socket.Rewind();
+        MessageFramer framer(socket);
+        std::string_view message;
+        while (framer.ReadMessage(message))
+        {
+            ++messages;
+        }
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "MessageFramer: " << messages / seconds << " messages/s, "
+              << stream.size() * passes / seconds / (1024 * 1024) << " MB/s" << std::endl;
+    EXPECT_EQ(messagesInStream * passes, messages);
+}
+
+namespace
+{
+    // Parses the stream again and again until 1 GB is parsed, returns MB/s
+    double MeasureFraming(const std::string& stream, MessageFramer::Framing framing, size_t expectedMessages)
+    {
+        const size_t total = 1024 * 1024 * 1024;
+        const size_t portion = 64 * 1024;
+        SocketStreamFake socket(stream, std::vector<size_t>(stream.size() / portion + 1, portion));
+
+        size_t parsed = 0;
+        auto start = std::chrono::steady_clock::now();
+        while (parsed < total)
+        {
+            socket.Rewind();
+            MessageFramer framer(socket);
+            framer.SetFraming(framing);
+            size_t messages = 0;
+            std::string_view message;
+            while (framer.ReadMessage(message))
+            {
+                ++messages;
+            }
+            EXPECT_EQ(expectedMessages, messages);
+            parsed += stream.size();
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return parsed / seconds / (1024 * 1024);
+    }
+}
+
+TEST(MessageFramerBenchmark, DISABLED_TerminatedVsLengthPrefixedOver1GB)
+{
+    // Chat lines of 16 to 256 bytes with an occasional pasted text of up to 64 KB
+    std::mt19937 random(42);
+    std::uniform_int_distribution<size_t> lineSize(16, 256);
+    std::uniform_int_distribution<size_t> pasteSize(1024, 64 * 1024);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    std::string terminated;
+    std::string prefixed;
+    size_t messages = 0;
+    while (terminated.size() < 16 * 1024 * 1024)
+    {
+        const std::string message(percent(random) == 0 ? pasteSize(random) : lineSize(random), 'x');
+        terminated.append(message).push_back('\0');
+        char prefix[MessageFramer::s_maxPrefixSize];
+        prefixed.append(prefix, MessageFramer::EncodeLength(message.size(), prefix)).append(message);
+        ++messages;
+    }
+
+    std::cout << "Terminated framing: " << MeasureFraming(terminated, MessageFramer::Framing::Terminated, messages) << " MB/s" << std::endl;
+    std::cout << "Length prefixed framing: " << MeasureFraming(prefixed, MessageFramer::Framing::LengthPrefixed, messages) << " MB/s" << std::endl;
+}
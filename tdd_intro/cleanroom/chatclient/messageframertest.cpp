@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "messageframer.h"
+#include "mocks.h"
+
+using namespace testing;
+
+namespace
+{
+    std::vector<std::string> ReadAllMessages(MessageFramer& framer)
+    {
+        std::vector<std::string> messages;
+        std::string_view message;
+        while (framer.ReadMessage(message))
+        {
+            messages.emplace_back(message);
+        }
+        return messages;
+    }
+
+    std::string FrameWithLength(const std::vector<std::string>& messages)
+    {
+        std::string stream;
+        for (const auto& message : messages)
+        {
+            char prefix[MessageFramer::s_maxPrefixSize];
+            stream.append(prefix, MessageFramer::EncodeLength(message.size(), prefix));
+            stream += message;
+        }
+        return stream;
+    }
+
+    std::string Frame(const std::vector<std::string>& messages)
+    {
+        std::string stream;
+        for (const auto& message : messages)
+        {
+            stream += message;
+            stream += '\0';
+        }
+        return stream;
+    }
+}
+
+TEST(MessageFramerTest, ReadsSingleMessage)
+{
+    SocketStreamFake socket(Frame({ "Hello!" }));
+    MessageFramer framer(socket);
+
+    std::string_view message;
+    ASSERT_TRUE(framer.ReadMessage(message));
+    EXPECT_EQ("Hello!", message);
+}
+
+TEST(MessageFramerTest, ReturnsFalseWhenConnectionClosed)
+{
+    SocketWrapperMock socket;
+    EXPECT_CALL(socket, Read(_, _)).WillOnce(Return(0));
+    MessageFramer framer(socket);
+
+    std::string_view message;
+    EXPECT_FALSE(framer.ReadMessage(message));
+}
+
+TEST(MessageFramerTest, DropsIncompleteMessageWhenConnectionClosed)
+{
+    SocketStreamFake socket(std::string("Hello!\0Bye", 10));
+    MessageFramer framer(socket);
+
+    EXPECT_EQ(std::vector<std::string>({ "Hello!" }), ReadAllMessages(framer));
+}
+
+TEST(MessageFramerTest, JoinsMessageSplitAcrossReads)
+{
+    SocketStreamFake socket(Frame({ "metizik:HELLO!" }), { 3, 5, 1 });
+    MessageFramer framer(socket);
+
+    EXPECT_EQ(std::vector<std::string>({ "metizik:HELLO!" }), ReadAllMessages(framer));
+}
+
+TEST(MessageFramerTest, SplitsMessagesSharingOneRead)
+{
+    SocketStreamFake socket(Frame({ "one", "", "three" }));
+    MessageFramer framer(socket);
+
+    EXPECT_EQ(std::vector<std::string>({ "one", "", "three" }), ReadAllMessages(framer));
+}
+
+TEST(MessageFramerTest, GrowsBufferForMessageLongerThanCapacity)
+{
+    const std::string longMessage(100, 'x');
+    SocketStreamFake socket(Frame({ "short", longMessage, "tail" }), { 7 });
+    MessageFramer framer(socket, 8);
+
+    EXPECT_EQ(std::vector<std::string>({ "short", longMessage, "tail" }), ReadAllMessages(framer));
+}
+
+TEST(MessageFramerTest, FuzzArbitrarySplitPoints)
+{
+    std::mt19937 random(4444);
+    for (int iteration = 0; iteration < 500; ++iteration)
+    {
+        std::vector<std::string> messages(random() % 20);
+        for (auto& message : messages)
+        {
+            message.resize(random() % 64);
+            for (auto& symbol : message)
+            {
+                symbol = static_cast<char>('a' + random() % 26);
+            }
+        }
+        const std::string stream = Frame(messages);
+
+        std::vector<size_t> portions;
+        for (size_t total = 0; total < stream.size();)
+        {
+            portions.push_back(1 + random() % 40);
+            total += portions.back();
+        }
+
+        SocketStreamFake socket(stream, portions);
+        MessageFramer framer(socket, 1 + random() % 32);
+
+        ASSERT_EQ(messages, ReadAllMessages(framer)) << "Iteration " << iteration;
+    }
+}
+
+TEST(MessageFramerTest, EncodesLengthAsVarint)
+{
+    char prefix[MessageFramer::s_maxPrefixSize];
+
+    ASSERT_EQ(1u, MessageFramer::EncodeLength(0x7f, prefix));
+    EXPECT_EQ('\x7f', prefix[0]);
+    ASSERT_EQ(2u, MessageFramer::EncodeLength(300, prefix));
+    EXPECT_EQ(std::string("\xac\x02"), std::string(prefix, 2));
+}
+
+TEST(MessageFramerTest, ReadsLengthPrefixedMessagesWithAnyBytes)
+{
+    const std::vector<std::string> messages = { "Hello!", std::string("a\0b", 3), "", std::string(300, 'x') };
+    SocketStreamFake socket(FrameWithLength(messages), { 1, 1, 7, 2, 100 });
+    MessageFramer framer(socket, 16);
+    framer.SetFraming(MessageFramer::Framing::LengthPrefixed);
+
+    EXPECT_EQ(messages, ReadAllMessages(framer));
+}
+
+TEST(MessageFramerTest, SwitchesFramingAfterHandshake)
+{
+    SocketStreamFake socket(Frame({ "metizik:HELLO!v2" }) + FrameWithLength({ std::string("\0\0", 2) }));
+    MessageFramer framer(socket);
+
+    std::string_view message;
+    ASSERT_TRUE(framer.ReadMessage(message));
+    EXPECT_EQ("metizik:HELLO!v2", message);
+    framer.SetFraming(MessageFramer::Framing::LengthPrefixed);
+    EXPECT_EQ(std::vector<std::string>({ std::string("\0\0", 2) }), ReadAllMessages(framer));
+}
+
+TEST(MessageFramerTest, ThrowsOnMalformatedLength)
+{
+    SocketStreamFake socket(std::string(MessageFramer::s_maxPrefixSize + 1, '\xff'));
+    MessageFramer framer(socket);
+    framer.SetFraming(MessageFramer::Framing::LengthPrefixed);
+
+    std::string_view message;
+    EXPECT_THROW(framer.ReadMessage(message), std::runtime_error);
+}
+
+TEST(MessageFramerTest, ThrowsOnTooLongMessage)
+{
+    char prefix[MessageFramer::s_maxPrefixSize];
+    const size_t size = MessageFramer::EncodeLength(MessageFramer::s_maxMessageSize, prefix);
+    prefix[0] |= 1; // One byte more than allowed
+    SocketStreamFake socket(std::string(prefix, size));
+    MessageFramer framer(socket);
+    framer.SetFraming(MessageFramer::Framing::LengthPrefixed);
+
+    std::string_view message;
+    EXPECT_THROW(framer.ReadMessage(message), std::runtime_error);
+}
+
+TEST(MessageFramerTest, ThrowsOnTooLongTerminatedMessage)
+{
+    // Terminator never comes, buffering stops right after the limit
+    SocketStreamFake socket(std::string(MessageFramer::s_maxMessageSize + 1, 'a'));
+    MessageFramer framer(socket);
+
+    std::string_view message;
+    EXPECT_THROW(framer.ReadMessage(message), std::runtime_error);
+}
+
+TEST(MessageFramerTest, ReadsTerminatedMessageOfMaxSize)
+{
+    const std::string longest(MessageFramer::s_maxMessageSize, 'a');
+    SocketStreamFake socket(Frame({ longest }));
+    MessageFramer framer(socket);
+
+    std::string_view message;
+    ASSERT_TRUE(framer.ReadMessage(message));
+    EXPECT_TRUE(message == longest);
+}
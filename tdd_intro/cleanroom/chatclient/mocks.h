@@ -1,6 +1,13 @@
 #pragma once
 #include <gmock/gmock.h>
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <stdexcept>
+#include <vector>
 #include "isocketwrapper.h"
+#include "icoscheduler.h"
+#include "itimer.h"
 #include "igui.h"
 
 class SocketWrapperMock : public ISocketWrapper
@@ -10,8 +17,13 @@ public:
     MOCK_METHOD0(Listen, void());
     MOCK_METHOD0(Accept, ISocketWrapperPtr());
     MOCK_METHOD2(Connect, ISocketWrapperPtr(const std::string& addr, int16_t port));
+    MOCK_METHOD2(TryConnect, ISocketWrapperPtr(const std::string& addr, int16_t port));
+    MOCK_METHOD0(FinishConnect, ISocketWrapperPtr());
     MOCK_METHOD1(Read, void(std::string& buffer));
+    MOCK_METHOD2(Read, size_t(char* buffer, size_t size));
     MOCK_METHOD1(Write, void(const std::string& buffer));
+    MOCK_METHOD2(WriteV, void(const ConstBuffer* buffers, size_t count));
+    MOCK_METHOD2(TryWriteV, size_t(const ConstBuffer* buffers, size_t count));
 };
 
 class GuiMock : public IGui
@@ -20,3 +32,136 @@ public:
     MOCK_METHOD0(Read, std::string());
     MOCK_METHOD1(Write, void(const std::string&));
 };
+
+// Fake connection, which delivers the given stream to the reader.
+// Each Read returns not more than the next portion size, to emulate the data split by network.
+// Everything written to it is collected in Written(). TryWriteV takes data only until the write budget
+// is spent, to emulate a slow peer.
+class SocketStreamFake : public ISocketWrapper
+{
+public:
+    explicit SocketStreamFake(const std::string& stream, const std::vector<size_t>& portions = std::vector<size_t>())
+        : m_stream(stream), m_position(0), m_portions(portions), m_nextPortion(0), m_portionLeft(0)
+        , m_writeBudget(SIZE_MAX), m_tryWrites(0)
+    { }
+
+    void Bind(const std::string&, int16_t) override { throw std::logic_error("Bind is not supported by fake"); }
+    void Listen() override { throw std::logic_error("Listen is not supported by fake"); }
+    ISocketWrapperPtr Accept() override { throw std::logic_error("Accept is not supported by fake"); }
+    ISocketWrapperPtr Connect(const std::string&, int16_t) override { throw std::logic_error("Connect is not supported by fake"); }
+    ISocketWrapperPtr TryConnect(const std::string&, int16_t) override { throw std::logic_error("Connect is not supported by fake"); }
+    ISocketWrapperPtr FinishConnect() override { throw std::logic_error("Connect is not supported by fake"); }
+
+    void Read(std::string& buffer) override
+    {
+        buffer.resize(1024);
+        buffer.resize(Read(&buffer[0], buffer.size()));
+    }
+
+    size_t Read(char* buffer, size_t size) override
+    {
+        size_t portion = std::min(size, m_stream.size() - m_position);
+        if (m_portionLeft == 0 && m_nextPortion < m_portions.size())
+        {
+            m_portionLeft = m_portions[m_nextPortion++];
+        }
+        if (m_portionLeft > 0)
+        {
+            portion = std::min(portion, m_portionLeft);
+            m_portionLeft -= portion;
+        }
+        std::copy(m_stream.data() + m_position, m_stream.data() + m_position + portion, buffer);
+        m_position += portion;
+        return portion;
+    }
+
+    void Write(const std::string& buffer) override { m_written += buffer; }
+
+    void WriteV(const ConstBuffer* buffers, size_t count) override
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            m_written.append(buffers[i].data, buffers[i].size);
+        }
+    }
+
+    size_t TryWriteV(const ConstBuffer* buffers, size_t count) override
+    {
+        ++m_tryWrites;
+        size_t written = 0;
+        for (size_t i = 0; i < count && m_writeBudget > 0; ++i)
+        {
+            const size_t portion = std::min(buffers[i].size, m_writeBudget);
+            m_written.append(buffers[i].data, portion);
+            written += portion;
+            if (m_writeBudget != SIZE_MAX)
+            {
+                m_writeBudget -= portion;
+            }
+        }
+        return written;
+    }
+
+    const std::string& Written() const { return m_written; }
+
+    // Limits the data taken by TryWriteV from now on, 0 means the peer doesn't read at all
+    void SetWriteBudget(size_t budget) { m_writeBudget = budget; }
+    size_t GetTryWriteCount() const { return m_tryWrites; }
+
+    // Starts delivering the stream from the beginning again
+    void Rewind()
+    {
+        m_position = 0;
+        m_nextPortion = 0;
+        m_portionLeft = 0;
+    }
+
+private:
+    std::string m_stream;
+    size_t m_position;
+    std::vector<size_t> m_portions;
+    size_t m_nextPortion;
+    size_t m_portionLeft;
+    std::string m_written;
+    size_t m_writeBudget;
+    size_t m_tryWrites;
+};
+
+// Scheduler, which considers every socket ready. Waiting coroutines are resumed only by RunUntilIdle,
+// in the order of their waits, so tests with SocketWrapperMock are deterministic.
+class CoSchedulerFake : public ICoScheduler
+{
+public:
+    void ResumeWhenReadable(ISocketWrapper&, std::coroutine_handle<> coroutine) override { m_ready.push_back(coroutine); }
+    void ResumeWhenWritable(ISocketWrapper&, std::coroutine_handle<> coroutine) override { m_ready.push_back(coroutine); }
+
+    // Resumes waiting coroutines, including the ones started waiting meanwhile. Returns number of resumptions.
+    size_t RunUntilIdle()
+    {
+        size_t resumed = 0;
+        while (!m_ready.empty())
+        {
+            std::coroutine_handle<> coroutine = m_ready.front();
+            m_ready.pop_front();
+            coroutine.resume();
+            ++resumed;
+        }
+        return resumed;
+    }
+
+    size_t GetWaitingCount() const { return m_ready.size(); }
+
+private:
+    std::deque<std::coroutine_handle<>> m_ready;
+};
+
+// Time, which goes forward only by Wait.
+class TimeFake : public ITime
+{
+public:
+    TimePoint GetCurrent() override { return m_current; }
+    void Wait(Duration duration) { m_current += duration; }
+
+private:
+    TimePoint m_current;
+};
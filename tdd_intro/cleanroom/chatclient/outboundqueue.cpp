@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "outboundqueue.h"
+
+namespace
+{
+    const size_t s_maxFlushChunks = 16; // Chunks gathered by one send
+}
+
+OutboundQueue::OutboundQueue(ISocketWrapper& socket, size_t lowWatermark, size_t highWatermark)
+    : m_socket(socket)
+    , m_lowWatermark(lowWatermark)
+    , m_highWatermark(highWatermark)
+    , m_sentFromFront(0)
+    , m_queuedSize(0)
+    , m_paused(false)
+{
+    if (lowWatermark >= highWatermark)
+    {
+        throw std::invalid_argument("Low watermark must be below the high one.");
+    }
+}
+
+void OutboundQueue::SetPauseHandler(PauseHandler handler)
+{
+    m_pauseHandler = std::move(handler);
+}
+
+void OutboundQueue::Push(std::string_view data)
+{
+    const ConstBuffer buffer = { data.data(), data.size() };
+    Push(&buffer, 1);
+}
+
+void OutboundQueue::Push(const ConstBuffer* buffers, size_t count)
+{
+    size_t sent = 0;
+    if (m_chunks.empty())
+    {
+        // Nothing is waiting for the socket, so the data goes out without copying
+        sent = m_socket.TryWriteV(buffers, count);
+    }
+
+    bool queued = false;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const size_t skip = std::min(sent, buffers[i].size);
+        sent -= skip;
+        if (skip < buffers[i].size)
+        {
+            Enqueue(std::string_view(buffers[i].data + skip, buffers[i].size - skip));
+            queued = true;
+        }
+    }
+    if (queued)
+    {
+        UpdatePause();
+    }
+}
+
+bool OutboundQueue::Flush()
+{
+    while (!m_chunks.empty())
+    {
+        ConstBuffer buffers[s_maxFlushChunks];
+        const size_t count = std::min(m_chunks.size(), s_maxFlushChunks);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const size_t skip = i == 0 ? m_sentFromFront : 0;
+            buffers[i] = ConstBuffer{ m_chunks[i].data() + skip, m_chunks[i].size() - skip };
+        }
+
+        size_t sent = m_socket.TryWriteV(buffers, count);
+        if (sent == 0)
+        {
+            break;
+        }
+        m_queuedSize -= sent;
+
+        // Drops fully sent chunks and remembers the sent part of the partially sent one
+        sent += m_sentFromFront;
+        while (!m_chunks.empty() && sent >= m_chunks.front().size())
+        {
+            sent -= m_chunks.front().size();
+            m_chunks.pop_front();
+        }
+        m_sentFromFront = sent;
+    }
+
+    UpdatePause();
+    return m_chunks.empty();
+}
+
+size_t OutboundQueue::GetQueuedSize() const
+{
+    return m_queuedSize;
+}
+
+bool OutboundQueue::IsEmpty() const
+{
+    return m_chunks.empty();
+}
+
+bool OutboundQueue::IsPaused() const
+{
+    return m_paused;
+}
+
+void OutboundQueue::Enqueue(std::string_view data)
+{
+    // The first chunk may be partially sent, appending to it is still fine
+    if (m_chunks.empty() || m_chunks.back().size() + data.size() > s_coalesceLimit)
+    {
+        m_chunks.emplace_back();
+    }
+    m_chunks.back().append(data.data(), data.size());
+    m_queuedSize += data.size();
+}
+
+void OutboundQueue::UpdatePause()
+{
+    bool paused = m_paused;
+    if (!m_paused && m_queuedSize >= m_highWatermark)
+    {
+        paused = true;
+    }
+    else if (m_paused && m_queuedSize <= m_lowWatermark)
+    {
+        paused = false;
+    }
+
+    if (paused != m_paused)
+    {
+        m_paused = paused;
+        if (m_pauseHandler)
+        {
+            m_pauseHandler(m_paused);
+        }
+    }
+}
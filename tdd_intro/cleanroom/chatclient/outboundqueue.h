@@ -0,0 +1,63 @@
+#pragma once
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include "isocketwrapper.h"
+
+/*
+ * Outbound data of one connection, sent without ever waiting for the socket.
+ *
+ * Push sends right away what the socket takes and queues the rest. While the queue is not empty,
+ * new messages are only queued: small ones are appended to the last queued chunk, so they go out
+ * with one send. The owner calls Flush when the socket becomes writable (EPOLLOUT for example).
+ *
+ * When the queued size reaches the high watermark, the pause handler is called with true,
+ * so the producer (the loop reading IGui, for example) stops making new messages.
+ * When it drops to the low watermark, the handler is called with false to resume the producer.
+ * Messages pushed while paused are still queued, the watermarks don't limit the queue.
+ *
+ * Exceptions of ISocketWrapper are passed through.
+*/
+
+class OutboundQueue
+{
+public:
+    using PauseHandler = std::function<void(bool paused)>;
+
+    static const size_t s_defaultLowWatermark = 64 * 1024;
+    static const size_t s_defaultHighWatermark = 256 * 1024;
+    // Queued chunk, to which small messages are appended
+    static const size_t s_coalesceLimit = 16 * 1024;
+
+    explicit OutboundQueue(ISocketWrapper& socket,
+                           size_t lowWatermark = s_defaultLowWatermark,
+                           size_t highWatermark = s_defaultHighWatermark);
+
+    void SetPauseHandler(PauseHandler handler);
+
+    // Sends the data or queues it, if the socket doesn't take everything.
+    void Push(std::string_view data);
+    // Same as Push of the buffers joined one after another, without joining them when nothing is queued.
+    void Push(const ConstBuffer* buffers, size_t count);
+    // Sends as much of the queued data as the socket takes. Returns true if nothing is left.
+    bool Flush();
+
+    size_t GetQueuedSize() const;
+    bool IsEmpty() const;
+    bool IsPaused() const;
+
+private:
+    void Enqueue(std::string_view data);
+    void UpdatePause();
+
+private:
+    ISocketWrapper& m_socket;
+    const size_t m_lowWatermark;
+    const size_t m_highWatermark;
+    PauseHandler m_pauseHandler;
+    std::deque<std::string> m_chunks;
+    size_t m_sentFromFront; // Part of the first chunk, which is already sent
+    size_t m_queuedSize;
+    bool m_paused;
+};
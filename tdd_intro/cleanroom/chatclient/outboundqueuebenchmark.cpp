@@ -0,0 +1,89 @@
+// Sender throughput with OutboundQueue over loopback, when all peers read and when one of them stalls.
+// It is disabled by default, run it with --gtest_also_run_disabled_tests.
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include "outboundqueue.h"
+#include "socketwrapper.h"
+
+namespace
+{
+    const char* s_address = "127.0.0.1";
+    const int16_t s_port = 4449;
+    const size_t s_peers = 4;
+    const size_t s_messages = 200000;
+
+    // Returns messages per second sent to every peer, which is not paused
+    double MeasureSender(bool stallOne)
+    {
+        SocketWrapper listener;
+        listener.Bind(s_address, s_port);
+        listener.Listen();
+
+        std::atomic<bool> stopped(false);
+        std::vector<std::thread> readers;
+        std::vector<ISocketWrapperPtr> connections;
+        for (size_t i = 0; i < s_peers; ++i)
+        {
+            const bool stalled = stallOne && i == 0;
+            readers.emplace_back([&stopped, stalled]()
+            {
+                SocketWrapper client;
+                auto connection = client.Connect(s_address, s_port);
+                char buffer[64 * 1024];
+                while (!stalled && connection->Read(buffer, sizeof(buffer)) > 0)
+                {
+                }
+                while (!stopped)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+            });
+            connections.push_back(listener.Accept());
+        }
+
+        std::vector<std::unique_ptr<OutboundQueue>> queues;
+        for (auto& connection : connections)
+        {
+            queues.emplace_back(new OutboundQueue(*connection));
+        }
+
+        const std::string message = std::string(63, 'x') + '\0';
+        size_t delivered = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < s_messages; ++i)
+        {
+            for (auto& queue : queues)
+            {
+                if (!queue->IsEmpty())
+                {
+                    queue->Flush();
+                }
+                // Producer skips the paused peer instead of waiting for it
+                if (!queue->IsPaused())
+                {
+                    queue->Push(message);
+                    ++delivered;
+                }
+            }
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        stopped = true;
+        connections.clear();
+        queues.clear();
+        for (auto& reader : readers)
+        {
+            reader.join();
+        }
+        return delivered / seconds;
+    }
+}
+
+TEST(OutboundQueueBenchmark, DISABLED_SenderThroughputWithStalledPeer)
+{
+    std::cout << "All peers read: " << MeasureSender(false) << " messages/s" << std::endl;
+    std::cout << "One peer stalls: " << MeasureSender(true) << " messages/s" << std::endl;
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "outboundqueue.h"
+#include "mocks.h"
+
+TEST(OutboundQueueTest, SendsRightAwayWhenPeerTakesEverything)
+{
+    SocketStreamFake peer("");
+    OutboundQueue queue(peer);
+
+    queue.Push("Hello!");
+
+    EXPECT_EQ("Hello!", peer.Written());
+    EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(OutboundQueueTest, QueuesWhatSlowPeerDoesNotTake)
+{
+    SocketStreamFake peer("");
+    peer.SetWriteBudget(3);
+    OutboundQueue queue(peer);
+
+    queue.Push("Hello!");
+
+    EXPECT_EQ("Hel", peer.Written());
+    EXPECT_EQ(3u, queue.GetQueuedSize());
+}
+
+TEST(OutboundQueueTest, QueuesBuffersFromPartiallySentOne)
+{
+    SocketStreamFake peer("");
+    peer.SetWriteBudget(4);
+    OutboundQueue queue(peer);
+    const ConstBuffer buffers[] = { { "metizik", 7 }, { ": ", 2 }, { "Hello!", 6 } };
+
+    queue.Push(buffers, 3);
+    peer.SetWriteBudget(SIZE_MAX);
+
+    EXPECT_EQ(11u, queue.GetQueuedSize());
+    EXPECT_TRUE(queue.Flush());
+    EXPECT_EQ("metizik: Hello!", peer.Written());
+}
+
+TEST(OutboundQueueTest, FlushSendsQueuedDataInOrder)
+{
+    SocketStreamFake peer("");
+    peer.SetWriteBudget(2);
+    OutboundQueue queue(peer);
+    queue.Push("Hello!");
+    queue.Push("How are you?");
+
+    EXPECT_FALSE(queue.Flush());
+    EXPECT_EQ("He", peer.Written());
+
+    peer.SetWriteBudget(SIZE_MAX);
+    EXPECT_TRUE(queue.Flush());
+    EXPECT_EQ("Hello!How are you?", peer.Written());
+    EXPECT_EQ(0u, queue.GetQueuedSize());
+}
+
+TEST(OutboundQueueTest, DoesNotTouchSocketWhileDataIsQueued)
+{
+    SocketStreamFake peer("");
+    peer.SetWriteBudget(0);
+    OutboundQueue queue(peer);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        queue.Push("message");
+    }
+
+    EXPECT_EQ(1u, peer.GetTryWriteCount());
+    EXPECT_EQ(70u, queue.GetQueuedSize());
+}
+
+TEST(OutboundQueueTest, CoalescesSmallMessagesIntoOneSend)
+{
+    SocketStreamFake peer("");
+    peer.SetWriteBudget(0);
+    OutboundQueue queue(peer);
+    for (int i = 0; i < 10; ++i)
+    {
+        queue.Push("message");
+    }
+
+    peer.SetWriteBudget(SIZE_MAX);
+    EXPECT_TRUE(queue.Flush());
+
+    EXPECT_EQ(2u, peer.GetTryWriteCount());
+    EXPECT_EQ(70u, peer.Written().size());
+}
+
+TEST(OutboundQueueTest, PausesProducerAtHighWatermarkAndResumesAtLow)
+{
+    SocketStreamFake peer("");
+    peer.SetWriteBudget(0);
+    OutboundQueue queue(peer, 4, 8);
+    std::vector<bool> notifications;
+    queue.SetPauseHandler([&notifications](bool paused) { notifications.push_back(paused); });
+
+    queue.Push("1234");
+    EXPECT_FALSE(queue.IsPaused());
+    queue.Push("5678");
+    EXPECT_TRUE(queue.IsPaused());
+
+    peer.SetWriteBudget(3);
+    queue.Flush();
+    EXPECT_TRUE(queue.IsPaused()); // 5 bytes left, above the low watermark
+
+    peer.SetWriteBudget(1);
+    queue.Flush();
+    EXPECT_FALSE(queue.IsPaused());
+    EXPECT_EQ(std::vector<bool>({ true, false }), notifications);
+}
+
+TEST(OutboundQueueTest, StalledPeerDoesNotBlockPush)
+{
+    SocketStreamFake peer("");
+    peer.SetWriteBudget(0);
+    OutboundQueue queue(peer);
+
+    const std::string message(1024, 'x');
+    for (int i = 0; i < 1024; ++i)
+    {
+        queue.Push(message);
+    }
+
+    EXPECT_EQ(1024u * 1024u, queue.GetQueuedSize());
+    EXPECT_TRUE(queue.IsPaused());
+    EXPECT_FALSE(queue.Flush());
+}
+
+TEST(OutboundQueueTest, ThrowsWhenLowWatermarkIsNotBelowHigh)
+{
+    SocketStreamFake peer("");
+
+    EXPECT_THROW(OutboundQueue(peer, 8, 8), std::invalid_argument);
+}
@@ -0,0 +1,132 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+/*
+ * Pool of equally sized memory blocks, carved from large slabs.
+ *
+ * Freed blocks are kept in a free list and given out again, so objects created and destroyed
+ * all the time (like the sockets of accepted connections) don't go to the general heap.
+ * Slabs are never returned to the heap. Pool is thread safe: a block may be freed by another thread.
+*/
+
+template <size_t BlockSize>
+class SlabPool
+{
+public:
+    static const size_t s_blocksPerSlab = 64;
+
+    // Pool is never destroyed, so blocks may be freed during static destruction
+    static SlabPool& Instance()
+    {
+        static SlabPool* pool = new SlabPool;
+        return *pool;
+    }
+
+    void* Allocate()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_free)
+        {
+            AddSlab();
+        }
+        FreeBlock* block = m_free;
+        m_free = block->next;
+        return block;
+    }
+
+    void Deallocate(void* pointer)
+    {
+        FreeBlock* block = static_cast<FreeBlock*>(pointer);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        block->next = m_free;
+        m_free = block;
+    }
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    static_assert(BlockSize >= sizeof(FreeBlock), "Block must fit the free list link.");
+    static_assert(BlockSize % alignof(std::max_align_t) == 0, "Blocks must stay aligned in the slab.");
+
+    SlabPool() : m_free(nullptr) { }
+
+    void AddSlab()
+    {
+        // Operator new aligns the slab for any fundamental type, blocks keep this alignment
+        m_slabs.emplace_back(new char[BlockSize * s_blocksPerSlab]);
+        char* slab = m_slabs.back().get();
+        for (size_t i = s_blocksPerSlab; i > 0; --i)
+        {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + (i - 1) * BlockSize);
+            block->next = m_free;
+            m_free = block;
+        }
+    }
+
+private:
+    std::mutex m_mutex;
+    FreeBlock* m_free;
+    std::vector<std::unique_ptr<char[]>> m_slabs;
+};
+
+/*
+ * Standard allocator over SlabPool, one pool per rounded object size.
+ *
+ * Use it with std::allocate_shared, so the object and the shared_ptr control block
+ * take one pooled block instead of two heap allocations:
+ *   ISocketWrapperPtr socket = std::allocate_shared<SocketWrapper>(SlabAllocator<SocketWrapper>(), ...);
+*/
+
+template <typename T>
+class SlabAllocator
+{
+public:
+    using value_type = T;
+
+    SlabAllocator() noexcept { }
+    template <typename U>
+    SlabAllocator(const SlabAllocator<U>&) noexcept { }
+
+    T* allocate(size_t count)
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported.");
+        if (count != 1)
+        {
+            return static_cast<T*>(::operator new(count * sizeof(T)));
+        }
+        return static_cast<T*>(Pool::Instance().Allocate());
+    }
+
+    void deallocate(T* pointer, size_t count) noexcept
+    {
+        if (count != 1)
+        {
+            ::operator delete(pointer);
+            return;
+        }
+        Pool::Instance().Deallocate(pointer);
+    }
+
+private:
+    static const size_t s_alignment = alignof(std::max_align_t);
+    using Pool = SlabPool<(sizeof(T) + s_alignment - 1) / s_alignment * s_alignment>;
+};
+
+template <typename T, typename U>
+bool operator==(const SlabAllocator<T>&, const SlabAllocator<U>&) noexcept
+{
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const SlabAllocator<T>&, const SlabAllocator<U>&) noexcept
+{
+    return false;
+}
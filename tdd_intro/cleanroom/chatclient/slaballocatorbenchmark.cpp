@@ -0,0 +1,81 @@
+// Cost of creating sockets of accepted connections with and without SlabAllocator.
+// They are disabled by default, run them with --gtest_also_run_disabled_tests.
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include "slaballocator.h"
+#include "socketwrapper.h"
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const size_t s_cycles = 20000;
+    const size_t s_allocations = 10000000;
+    const size_t s_liveObjects = 1000;
+
+    // Object of the same size as the real socket, which can be created without a connection
+    struct SocketSized : public ISocketWrapper
+    {
+        void Bind(const std::string&, int16_t) override { }
+        void Listen() override { }
+        ISocketWrapperPtr Accept() override { return nullptr; }
+        ISocketWrapperPtr Connect(const std::string&, int16_t) override { return nullptr; }
+        ISocketWrapperPtr TryConnect(const std::string&, int16_t) override { return nullptr; }
+        ISocketWrapperPtr FinishConnect() override { return nullptr; }
+        void Read(std::string&) override { }
+        size_t Read(char*, size_t) override { return 0; }
+        void Write(const std::string&) override { }
+        void WriteV(const ConstBuffer*, size_t) override { }
+        size_t TryWriteV(const ConstBuffer*, size_t) override { return 0; }
+
+        char state[sizeof(SocketWrapper) - sizeof(ISocketWrapper)];
+    };
+
+    // Keeps a window of live objects, like a server with connection churn
+    template <typename Create>
+    double MeasureAllocations(Create create)
+    {
+        std::vector<ISocketWrapperPtr> live(s_liveObjects);
+        auto start = Clock::now();
+        for (size_t i = 0; i < s_allocations; ++i)
+        {
+            live[i % s_liveObjects] = create();
+        }
+        return s_allocations / std::chrono::duration<double>(Clock::now() - start).count();
+    }
+}
+
+TEST(SlabAllocatorBenchmark, DISABLED_SocketAllocations)
+{
+    std::cout << "shared_ptr(new): " << MeasureAllocations([]()
+    {
+        return ISocketWrapperPtr(new SocketSized);
+    }) << " sockets/s" << std::endl;
+
+    std::cout << "allocate_shared(SlabAllocator): " << MeasureAllocations([]()
+    {
+        return std::allocate_shared<SocketSized>(SlabAllocator<SocketSized>());
+    }) << " sockets/s" << std::endl;
+}
+
+TEST(SlabAllocatorBenchmark, DISABLED_AcceptCloseCycles)
+{
+    const char* address = "127.0.0.1";
+    const int16_t port = 4448;
+
+    SocketWrapper listener;
+    listener.Bind(address, port);
+    listener.Listen();
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < s_cycles; ++i)
+    {
+        SocketWrapper client;
+        auto connected = client.Connect(address, port);
+        auto accepted = listener.Accept();
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::cout << "Accept/close: " << s_cycles / seconds << " cycles/s" << std::endl;
+}
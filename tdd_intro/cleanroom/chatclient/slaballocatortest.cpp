@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <thread>
+#include "slaballocator.h"
+
+namespace
+{
+    struct Counted
+    {
+        explicit Counted(int& alive) : alive(alive) { ++alive; }
+        ~Counted() { --alive; }
+
+        int& alive;
+        char payload[40];
+    };
+}
+
+TEST(SlabAllocatorTest, ReusesFreedBlock)
+{
+    SlabAllocator<Counted> allocator;
+
+    Counted* first = allocator.allocate(1);
+    allocator.deallocate(first, 1);
+    Counted* second = allocator.allocate(1);
+
+    EXPECT_EQ(first, second);
+    allocator.deallocate(second, 1);
+}
+
+TEST(SlabAllocatorTest, GivesDistinctBlocksBeyondOneSlab)
+{
+    SlabAllocator<Counted> allocator;
+    std::set<Counted*> blocks;
+
+    const size_t count = 3 * SlabPool<64>::s_blocksPerSlab;
+    for (size_t i = 0; i < count; ++i)
+    {
+        blocks.insert(allocator.allocate(1));
+    }
+
+    EXPECT_EQ(count, blocks.size());
+    for (Counted* block : blocks)
+    {
+        allocator.deallocate(block, 1);
+    }
+}
+
+TEST(SlabAllocatorTest, AllocateSharedConstructsAndDestroysObject)
+{
+    int alive = 0;
+    {
+        auto object = std::allocate_shared<Counted>(SlabAllocator<Counted>(), alive);
+        EXPECT_EQ(1, alive);
+        std::shared_ptr<Counted> copy = object;
+        object.reset();
+        EXPECT_EQ(1, alive);
+    }
+    EXPECT_EQ(0, alive);
+}
+
+TEST(SlabAllocatorTest, BlockCanBeFreedByAnotherThread)
+{
+    int alive = 0;
+    auto object = std::allocate_shared<Counted>(SlabAllocator<Counted>(), alive);
+
+    std::thread([&object]() { object.reset(); }).join();
+
+    EXPECT_EQ(0, alive);
+}
+
+TEST(SlabAllocatorTest, ArraysGoToHeap)
+{
+    SlabAllocator<Counted> allocator;
+
+    Counted* array = allocator.allocate(3);
+    ASSERT_NE(nullptr, array);
+    allocator.deallocate(array, 3);
+}
@@ -3,14 +3,19 @@
 
 #include <winsock2.h>
 #include <ws2tcpip.h>
+#include <algorithm>
 #include <exception>
-#include <vector>
 #include <sstream>
+#include <stdexcept>
 
 #include "SocketWrapper.h"
+#include "slaballocator.h"
 
 namespace
 {
+    const size_t s_readPortionSize = 1024; // 1KB
+    const size_t s_maxWriteVectors = 16; // Buffers gathered by one WSASend call
+
     std::string GetExceptionString(const std::string& message, int errorCode)
     {
         return message + " " + std::to_string(errorCode) + "\n";
@@ -100,7 +105,7 @@ ISocketWrapperPtr SocketWrapper::Accept()
     {
         throw std::runtime_error(GetExceptionString("Failed to connect to client.", WSAGetLastError()));
     }
-    return ISocketWrapperPtr(new SocketWrapper(other));
+    return std::allocate_shared<SocketWrapper>(SlabAllocator<SocketWrapper>(), other);
 }
 
 ISocketWrapperPtr SocketWrapper::Connect(const std::string& addr, int16_t port)
@@ -114,28 +119,114 @@ ISocketWrapperPtr SocketWrapper::Connect(const std::string& addr, int16_t port)
     {
         throw std::runtime_error(GetExceptionString("Failed to connect to server.", WSAGetLastError()));
     }
-    return ISocketWrapperPtr(new SocketWrapper(other));
+    return std::allocate_shared<SocketWrapper>(SlabAllocator<SocketWrapper>(), other);
+}
+
+ISocketWrapperPtr SocketWrapper::TryConnect(const std::string& addr, int16_t port)
+{
+    // Socket is blocking, so the connection is always established right away
+    return Connect(addr, port);
+}
+
+ISocketWrapperPtr SocketWrapper::FinishConnect()
+{
+    throw std::logic_error("Connection is never in progress for the blocking socket.");
 }
 
 void SocketWrapper::Read(std::string& buffer)
 {
-    std::vector<char> bufferTmp(1024); // 1KB
-    int portionReceived = recv(m_socket, bufferTmp.data(), static_cast<int>(bufferTmp.size()), 0);
+    buffer.resize(s_readPortionSize); // Reuses capacity of the caller's buffer
+    buffer.resize(Read(&buffer[0], buffer.size()));
+}
+
+size_t SocketWrapper::Read(char* buffer, size_t size)
+{
+    int portionReceived = recv(m_socket, buffer, static_cast<int>(size), 0);
     if (SOCKET_ERROR == portionReceived)
     {
         throw std::runtime_error(GetExceptionString("Failed to read data.", WSAGetLastError()));
     }
-    buffer.assign(bufferTmp.begin(), bufferTmp.begin() + portionReceived);
+    return static_cast<size_t>(portionReceived);
 }
 
 void SocketWrapper::Write(const std::string& buffer)
 {
-    for (int dataSent = 0; dataSent < buffer.size();)
+    for (size_t dataSent = 0; dataSent < buffer.size();)
     {
-        dataSent += send(m_socket, buffer.data() + dataSent, static_cast<int>(buffer.size() - dataSent), 0);
-        if (SOCKET_ERROR == dataSent)
+        int portionSent = send(m_socket, buffer.data() + dataSent, static_cast<int>(buffer.size() - dataSent), 0);
+        if (SOCKET_ERROR == portionSent)
         {
             throw std::runtime_error(GetExceptionString("Failed to send data.", WSAGetLastError()));
         }
+        dataSent += static_cast<size_t>(portionSent);
+    }
+}
+
+void SocketWrapper::WriteV(const ConstBuffer* buffers, size_t count)
+{
+    WSABUF vectors[s_maxWriteVectors];
+    while (count > 0)
+    {
+        DWORD pendingCount = static_cast<DWORD>(std::min(count, s_maxWriteVectors));
+        for (DWORD i = 0; i < pendingCount; ++i)
+        {
+            vectors[i].buf = const_cast<char*>(buffers[i].data);
+            vectors[i].len = static_cast<ULONG>(buffers[i].size);
+        }
+        buffers += pendingCount;
+        count -= pendingCount;
+
+        WSABUF* pending = vectors;
+        while (pendingCount > 0)
+        {
+            DWORD dataSent = 0;
+            if (WSASend(m_socket, pending, pendingCount, &dataSent, 0, nullptr, nullptr) == SOCKET_ERROR)
+            {
+                throw std::runtime_error(GetExceptionString("Failed to send data.", WSAGetLastError()));
+            }
+
+            // Skips fully sent buffers and moves the beginning of partially sent one
+            while (pendingCount > 0 && dataSent >= pending->len)
+            {
+                dataSent -= pending->len;
+                ++pending;
+                --pendingCount;
+            }
+            if (pendingCount > 0)
+            {
+                pending->buf += dataSent;
+                pending->len -= dataSent;
+            }
+        }
+    }
+}
+
+size_t SocketWrapper::TryWriteV(const ConstBuffer* buffers, size_t count)
+{
+    WSABUF vectors[s_maxWriteVectors];
+    const DWORD vectorCount = static_cast<DWORD>(std::min(count, s_maxWriteVectors));
+    for (DWORD i = 0; i < vectorCount; ++i)
+    {
+        vectors[i].buf = const_cast<char*>(buffers[i].data);
+        vectors[i].len = static_cast<ULONG>(buffers[i].size);
+    }
+
+    // Socket is blocking on Windows, it is switched to non-blocking mode just for this send
+    u_long nonBlocking = 1;
+    ioctlsocket(m_socket, FIONBIO, &nonBlocking);
+    DWORD dataSent = 0;
+    const int result = WSASend(m_socket, vectors, vectorCount, &dataSent, 0, nullptr, nullptr);
+    const int error = WSAGetLastError();
+    u_long blocking = 0;
+    ioctlsocket(m_socket, FIONBIO, &blocking);
+
+    if (result == SOCKET_ERROR)
+    {
+        if (error == WSAEWOULDBLOCK)
+        {
+            return 0;
+        }
+        throw std::runtime_error(GetExceptionString("Failed to send data.", error));
     }
+    return dataSent;
 }
@@ -1,5 +1,7 @@
 #pragma once
 #include "isocketwrapper.h"
+
+#ifdef _WIN32
 #include <Windows.h>
 
 class SocketWrapper : public ISocketWrapper
@@ -12,9 +14,60 @@ public:
     void Listen();
     ISocketWrapperPtr Accept();
     ISocketWrapperPtr Connect(const std::string& addr, int16_t port);
+    ISocketWrapperPtr TryConnect(const std::string& addr, int16_t port);
+    ISocketWrapperPtr FinishConnect();
     void Read(std::string& buffer);
+    size_t Read(char* buffer, size_t size);
     void Write(const std::string& buffer);
+    void WriteV(const ConstBuffer* buffers, size_t count);
+    size_t TryWriteV(const ConstBuffer* buffers, size_t count);
 
 private:
     SOCKET m_socket;
 };
+
+#else
+#include "epollreactor.h"
+
+/*
+ * POSIX implementation over non-blocking socket.
+ *
+ * Blocking calls of ISocketWrapper wait for readiness through the EpollReactor,
+ * so handlers of other descriptors registered in the same reactor keep being dispatched
+ * while this socket waits. Unless the reactor is given explicitly, the one of the calling thread is used.
+*/
+class SocketWrapper : public ISocketWrapper
+{
+public:
+    SocketWrapper();
+    explicit SocketWrapper(EpollReactor& reactor);
+    SocketWrapper(int other, EpollReactor* reactor);
+    ~SocketWrapper();
+    void Bind(const std::string& addr, int16_t port);
+    void Listen();
+    ISocketWrapperPtr Accept();
+    ISocketWrapperPtr Connect(const std::string& addr, int16_t port);
+    ISocketWrapperPtr TryConnect(const std::string& addr, int16_t port);
+    ISocketWrapperPtr FinishConnect();
+    void Read(std::string& buffer);
+    size_t Read(char* buffer, size_t size);
+    void Write(const std::string& buffer);
+    void WriteV(const ConstBuffer* buffers, size_t count);
+    size_t TryWriteV(const ConstBuffer* buffers, size_t count);
+
+    // Accepts the incoming connection without waiting, returns nullptr if there is none pending.
+    std::shared_ptr<SocketWrapper> TryAccept();
+    // Native descriptor, to register the socket in the reactor for the readiness events.
+    int Handle() const;
+
+private:
+    void WaitFor(uint32_t events);
+    // New socket sharing the connection of this one
+    ISocketWrapperPtr Duplicate();
+
+private:
+    int m_socket;
+    EpollReactor* m_reactor;
+};
+
+#endif
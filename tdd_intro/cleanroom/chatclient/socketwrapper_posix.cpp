@@ -0,0 +1,327 @@
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include "socketwrapper.h"
+#include "slaballocator.h"
+
+namespace
+{
+    const size_t s_readPortionSize = 1024; // 1KB
+    const size_t s_maxWriteVectors = 16; // Buffers gathered by one sendmsg call
+
+    std::string GetExceptionString(const std::string& message, int errorCode)
+    {
+        return message + " " + std::to_string(errorCode) + " " + std::strerror(errorCode) + "\n";
+    }
+
+    void SetNonBlocking(int socket)
+    {
+        int flags = fcntl(socket, F_GETFL, 0);
+        if (flags == -1 || fcntl(socket, F_SETFL, flags | O_NONBLOCK) == -1)
+        {
+            throw std::runtime_error(GetExceptionString("Failed to set socket to non-blocking mode.", errno));
+        }
+    }
+
+    sockaddr_in MakeAddress(const std::string& addr, int16_t port)
+    {
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = inet_addr(addr.data());
+        address.sin_port = htons(static_cast<uint16_t>(port));
+        return address;
+    }
+
+    bool WouldBlock(int errorCode)
+    {
+        return errorCode == EAGAIN || errorCode == EWOULDBLOCK;
+    }
+}
+
+SocketWrapper::SocketWrapper()
+    : m_socket(socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, IPPROTO_TCP))
+    , m_reactor(nullptr)
+{
+    if (m_socket == -1)
+    {
+        throw std::runtime_error(GetExceptionString("Failed to create socket to listen on.", errno));
+    }
+    SetNonBlocking(m_socket);
+}
+
+SocketWrapper::SocketWrapper(EpollReactor& reactor)
+    : SocketWrapper()
+{
+    m_reactor = &reactor;
+}
+
+SocketWrapper::SocketWrapper(int other, EpollReactor* reactor)
+    : m_socket(other)
+    , m_reactor(reactor)
+{
+    SetNonBlocking(m_socket);
+    // Small chat messages go out right away, batching is left to TransmitBatcher
+    int noDelay = 1;
+    setsockopt(m_socket, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+}
+
+SocketWrapper::~SocketWrapper()
+{
+    close(m_socket);
+}
+
+void SocketWrapper::Bind(const std::string& addr, int16_t port)
+{
+    // Allows to rebind the port right after the previous listener is closed
+    int reuse = 1;
+    setsockopt(m_socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address = MakeAddress(addr, port);
+    if (bind(m_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
+    {
+        throw std::runtime_error(GetExceptionString("Failed to bind socket to address.", errno));
+    }
+}
+
+void SocketWrapper::Listen()
+{
+    if (listen(m_socket, SOMAXCONN) == -1)
+    {
+        throw std::runtime_error(GetExceptionString("Failed to listen on socket.", errno));
+    }
+}
+
+ISocketWrapperPtr SocketWrapper::Accept()
+{
+    for (;;)
+    {
+        if (auto other = TryAccept())
+        {
+            return other;
+        }
+        WaitFor(EPOLLIN);
+    }
+}
+
+ISocketWrapperPtr SocketWrapper::Connect(const std::string& addr, int16_t port)
+{
+    if (auto connected = TryConnect(addr, port))
+    {
+        return connected;
+    }
+    WaitFor(EPOLLOUT);
+    return FinishConnect();
+}
+
+ISocketWrapperPtr SocketWrapper::TryConnect(const std::string& addr, int16_t port)
+{
+    sockaddr_in address = MakeAddress(addr, port);
+    if (connect(m_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
+    {
+        // Interrupted connect goes on asynchronously as well
+        if (errno != EINPROGRESS && errno != EINTR)
+        {
+            throw std::runtime_error(GetExceptionString("Failed to connect to server.", errno));
+        }
+        return nullptr;
+    }
+    return Duplicate();
+}
+
+ISocketWrapperPtr SocketWrapper::FinishConnect()
+{
+    int error = 0;
+    socklen_t errorSize = sizeof(error);
+    getsockopt(m_socket, SOL_SOCKET, SO_ERROR, &error, &errorSize);
+    if (error != 0)
+    {
+        throw std::runtime_error(GetExceptionString("Failed to connect to server.", error));
+    }
+    return Duplicate();
+}
+
+ISocketWrapperPtr SocketWrapper::Duplicate()
+{
+    // This socket is connected now, the returned one shares the same connection
+    int other = dup(m_socket);
+    if (other == -1)
+    {
+        throw std::runtime_error(GetExceptionString("Failed to duplicate connected socket.", errno));
+    }
+    return std::allocate_shared<SocketWrapper>(SlabAllocator<SocketWrapper>(), other, m_reactor);
+}
+
+void SocketWrapper::Read(std::string& buffer)
+{
+    buffer.resize(s_readPortionSize); // Reuses capacity of the caller's buffer
+    buffer.resize(Read(&buffer[0], buffer.size()));
+}
+
+size_t SocketWrapper::Read(char* buffer, size_t size)
+{
+    for (;;)
+    {
+        ssize_t portionReceived = recv(m_socket, buffer, size, 0);
+        if (portionReceived != -1)
+        {
+            return static_cast<size_t>(portionReceived);
+        }
+        if (!WouldBlock(errno) && errno != EINTR)
+        {
+            throw std::runtime_error(GetExceptionString("Failed to read data.", errno));
+        }
+        WaitFor(EPOLLIN);
+    }
+}
+
+void SocketWrapper::Write(const std::string& buffer)
+{
+    for (size_t dataSent = 0; dataSent < buffer.size();)
+    {
+        ssize_t portionSent = send(m_socket, buffer.data() + dataSent, buffer.size() - dataSent, MSG_NOSIGNAL);
+        if (portionSent != -1)
+        {
+            dataSent += static_cast<size_t>(portionSent);
+            continue;
+        }
+        if (!WouldBlock(errno) && errno != EINTR)
+        {
+            throw std::runtime_error(GetExceptionString("Failed to send data.", errno));
+        }
+        WaitFor(EPOLLOUT);
+    }
+}
+
+void SocketWrapper::WriteV(const ConstBuffer* buffers, size_t count)
+{
+    iovec vectors[s_maxWriteVectors];
+    while (count > 0)
+    {
+        size_t pendingCount = std::min(count, s_maxWriteVectors);
+        for (size_t i = 0; i < pendingCount; ++i)
+        {
+            vectors[i].iov_base = const_cast<char*>(buffers[i].data);
+            vectors[i].iov_len = buffers[i].size;
+        }
+        buffers += pendingCount;
+        count -= pendingCount;
+
+        iovec* pending = vectors;
+        while (pendingCount > 0)
+        {
+            msghdr message = {};
+            message.msg_iov = pending;
+            message.msg_iovlen = pendingCount;
+            ssize_t portionSent = sendmsg(m_socket, &message, MSG_NOSIGNAL);
+            if (portionSent == -1)
+            {
+                if (!WouldBlock(errno) && errno != EINTR)
+                {
+                    throw std::runtime_error(GetExceptionString("Failed to send data.", errno));
+                }
+                WaitFor(EPOLLOUT);
+                continue;
+            }
+
+            // Skips fully sent buffers and moves the beginning of partially sent one
+            size_t dataSent = static_cast<size_t>(portionSent);
+            while (pendingCount > 0 && dataSent >= pending->iov_len)
+            {
+                dataSent -= pending->iov_len;
+                ++pending;
+                --pendingCount;
+            }
+            if (pendingCount > 0)
+            {
+                pending->iov_base = static_cast<char*>(pending->iov_base) + dataSent;
+                pending->iov_len -= dataSent;
+            }
+        }
+    }
+}
+
+size_t SocketWrapper::TryWriteV(const ConstBuffer* buffers, size_t count)
+{
+    iovec vectors[s_maxWriteVectors];
+    const size_t vectorCount = std::min(count, s_maxWriteVectors);
+    for (size_t i = 0; i < vectorCount; ++i)
+    {
+        vectors[i].iov_base = const_cast<char*>(buffers[i].data);
+        vectors[i].iov_len = buffers[i].size;
+    }
+
+    msghdr message = {};
+    message.msg_iov = vectors;
+    message.msg_iovlen = vectorCount;
+    for (;;)
+    {
+        ssize_t portionSent = sendmsg(m_socket, &message, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (portionSent != -1)
+        {
+            return static_cast<size_t>(portionSent);
+        }
+        if (WouldBlock(errno))
+        {
+            return 0;
+        }
+        if (errno != EINTR)
+        {
+            throw std::runtime_error(GetExceptionString("Failed to send data.", errno));
+        }
+    }
+}
+
+std::shared_ptr<SocketWrapper> SocketWrapper::TryAccept()
+{
+    for (;;)
+    {
+        int other = accept4(m_socket, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (other != -1)
+        {
+            return std::allocate_shared<SocketWrapper>(SlabAllocator<SocketWrapper>(), other, m_reactor);
+        }
+        if (WouldBlock(errno))
+        {
+            return nullptr;
+        }
+        if (errno != EINTR)
+        {
+            throw std::runtime_error(GetExceptionString("Failed to connect to client.", errno));
+        }
+    }
+}
+
+int SocketWrapper::Handle() const
+{
+    return m_socket;
+}
+
+void SocketWrapper::WaitFor(uint32_t events)
+{
+    EpollReactor& reactor = m_reactor ? *m_reactor : EpollReactor::ThreadDefault();
+    bool ready = false;
+    reactor.Register(m_socket, events | EPOLLONESHOT, [&ready](uint32_t) { ready = true; });
+    try
+    {
+        while (!ready)
+        {
+            reactor.Poll(-1);
+        }
+    }
+    catch (...)
+    {
+        reactor.Unregister(m_socket);
+        throw;
+    }
+    reactor.Unregister(m_socket);
+}
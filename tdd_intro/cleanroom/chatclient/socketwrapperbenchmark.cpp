@@ -0,0 +1,86 @@
+// Benchmarks for the real SocketWrapper implementation over loopback.
+// They are disabled by default, run them with --gtest_also_run_disabled_tests.
+#include <gtest/gtest.h>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "socketwrapper.h"
+
+namespace
+{
+    const char* s_address = "127.0.0.1";
+    const int16_t s_port = 4445;
+    const size_t s_transferSize = 256 * 1024 * 1024; // 256MB
+    const size_t s_chunkSize = 64 * 1024;
+    // Every variant reads the same portions as Read(std::string&), so only the buffer handling differs
+    const size_t s_readSize = 1024;
+
+    // Sends s_transferSize bytes from the accepted side and measures how fast
+    // the connected side receives them with the given read function.
+    void MeasureThroughput(const std::string& name, std::function<size_t(SocketWrapper&)> read)
+    {
+        SocketWrapper listener;
+        SocketWrapper client;
+        listener.Bind(s_address, s_port);
+        listener.Listen();
+        client.Connect(s_address, s_port);
+        auto server = listener.Accept();
+
+        auto start = std::chrono::steady_clock::now();
+        std::thread writer([server]()
+        {
+            const std::string chunk(s_chunkSize, 'x');
+            for (size_t sent = 0; sent < s_transferSize; sent += chunk.size())
+            {
+                server->Write(chunk);
+            }
+        });
+
+        size_t received = 0;
+        while (received < s_transferSize)
+        {
+            size_t portion = read(client);
+            ASSERT_NE(0u, portion);
+            received += portion;
+        }
+        writer.join();
+
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << name << ": " << received / seconds / (1024 * 1024) << " MB/s" << std::endl;
+        EXPECT_EQ(s_transferSize, received);
+    }
+}
+
+TEST(SocketWrapperBenchmark, DISABLED_LoopbackThroughputTemporaryVector)
+{
+    // Read(std::string&) before the caller's buffer was reused: new vector for every read, then a copy
+    std::string buffer;
+    MeasureThroughput("Temporary vector and assign", [&buffer](SocketWrapper& socket)
+    {
+        std::vector<char> bufferTmp(s_readSize);
+        const size_t received = socket.Read(bufferTmp.data(), bufferTmp.size());
+        buffer.assign(bufferTmp.begin(), bufferTmp.begin() + received);
+        return buffer.size();
+    });
+}
+
+TEST(SocketWrapperBenchmark, DISABLED_LoopbackThroughput)
+{
+    std::string buffer;
+    MeasureThroughput("Read(std::string&)", [&buffer](SocketWrapper& socket)
+    {
+        socket.Read(buffer);
+        return buffer.size();
+    });
+}
+
+TEST(SocketWrapperBenchmark, DISABLED_LoopbackThroughputCallerBuffer)
+{
+    std::vector<char> buffer(s_readSize);
+    MeasureThroughput("Read(char*, size_t)", [&buffer](SocketWrapper& socket)
+    {
+        return socket.Read(buffer.data(), buffer.size());
+    });
+}
@@ -1,5 +1,10 @@
-// Tests for the real SocketWrapper implementation for Windows.
+// Tests for the real SocketWrapper implementations for Windows and POSIX.
 #include <gtest/gtest.h>
+#ifndef _WIN32
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
 #include "socketwrapper.h"
 
 TEST(SocketWrapperTest, EstablishConnection)
@@ -25,3 +30,124 @@ TEST(SocketWrapperTest, EstablishConnection)
 
     EXPECT_STREQ(testPhrase, str.c_str());
 }
+
+TEST(SocketWrapperTest, ReadIntoCallerBuffer)
+{
+    SocketWrapper listener;
+    SocketWrapper client;
+
+    const char* address = "127.0.0.1";
+    const int port = 4444;
+
+    listener.Bind(address, port);
+    listener.Listen();
+    client.Connect(address, port);
+    auto server = listener.Accept();
+
+    const std::string testPhrase = "bla-bla-bla";
+
+    server->Write(testPhrase);
+    char buffer[64] = {};
+    size_t received = client.Read(buffer, sizeof(buffer));
+
+    EXPECT_EQ(testPhrase, std::string(buffer, received));
+}
+
+TEST(SocketWrapperTest, WriteGathersBuffers)
+{
+    SocketWrapper listener;
+    SocketWrapper client;
+
+    const char* address = "127.0.0.1";
+    const int port = 4444;
+
+    listener.Bind(address, port);
+    listener.Listen();
+    client.Connect(address, port);
+    auto server = listener.Accept();
+
+    const std::string nickname = "metizik";
+    const std::string message = "Hello!";
+    const ConstBuffer buffers[] = { { nickname.data(), nickname.size() },
+                                    { ":", 1 },
+                                    { message.data(), message.size() + 1 } }; // with '\0' terminator
+    server->WriteV(buffers, 3);
+
+    const std::string expected("metizik:Hello!\0", 15);
+    std::string received;
+    std::string portion;
+    while (received.size() < expected.size())
+    {
+        client.Read(portion);
+        ASSERT_FALSE(portion.empty());
+        received += portion;
+    }
+
+    EXPECT_EQ(expected, received);
+}
+
+TEST(SocketWrapperTest, TryWriteStopsWhenPeerDoesNotRead)
+{
+    SocketWrapper listener;
+    SocketWrapper client;
+
+    const char* address = "127.0.0.1";
+    const int port = 4444;
+
+    listener.Bind(address, port);
+    listener.Listen();
+    client.Connect(address, port);
+    auto server = listener.Accept();
+
+    const std::string chunk(64 * 1024, 'x');
+    const ConstBuffer buffer = { chunk.data(), chunk.size() };
+    size_t written = 0;
+    for (size_t portion = 1; portion > 0; written += portion)
+    {
+        portion = server->TryWriteV(&buffer, 1);
+    }
+
+    EXPECT_LT(0u, written);
+    EXPECT_EQ(0u, server->TryWriteV(&buffer, 1));
+}
+
+#ifndef _WIN32
+TEST(SocketWrapperTest, TryAcceptReturnsNullWithoutPendingConnection)
+{
+    SocketWrapper listener;
+    SocketWrapper client;
+
+    const char* address = "127.0.0.1";
+    const int port = 4444;
+
+    listener.Bind(address, port);
+    listener.Listen();
+    EXPECT_EQ(nullptr, listener.TryAccept());
+
+    client.Connect(address, port);
+    EXPECT_NE(nullptr, listener.Accept());
+    EXPECT_EQ(nullptr, listener.TryAccept());
+}
+
+TEST(SocketWrapperTest, ConnectionsDisableNagle)
+{
+    SocketWrapper listener;
+    SocketWrapper client;
+
+    const char* address = "127.0.0.1";
+    const int port = 4444;
+
+    listener.Bind(address, port);
+    listener.Listen();
+    auto connection = client.Connect(address, port);
+    auto server = listener.Accept();
+
+    for (auto socket : { connection, server })
+    {
+        int noDelay = 0;
+        socklen_t size = sizeof(noDelay);
+        getsockopt(static_cast<SocketWrapper&>(*socket).Handle(), IPPROTO_TCP, TCP_NODELAY, &noDelay, &size);
+        EXPECT_NE(0, noDelay);
+    }
+}
+#endif
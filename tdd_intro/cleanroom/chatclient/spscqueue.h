@@ -0,0 +1,102 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/*
+ * Bounded lock-free queue for exactly one producer thread and one consumer thread.
+ *
+ * Chat client uses it to hand the lines typed in IGui over to the thread writing to the socket,
+ * and the received messages back to the GUI thread, so neither of them blocks the other.
+ *
+ * Slots form a ring, which size is the capacity rounded up to the power of two.
+ * Producer only advances the tail and consumer only advances the head, each side keeps
+ * the last seen position of the other one and rereads it only when the ring looks full (or empty).
+ * Nothing is allocated after construction, values are moved in and out of the slots.
+*/
+
+template <typename T>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(size_t capacity)
+        : m_slots(RoundUpToPowerOfTwo(capacity))
+        , m_mask(m_slots.size() - 1)
+        , m_head(0)
+        , m_cachedTail(0)
+        , m_tail(0)
+        , m_cachedHead(0)
+    { }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    size_t Capacity() const
+    {
+        return m_slots.size();
+    }
+
+    // Producer side. Returns false and leaves the value untouched if the queue is full.
+    bool TryPush(T&& value)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead == m_slots.size())
+        {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead == m_slots.size())
+            {
+                return false;
+            }
+        }
+        m_slots[tail & m_mask] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPush(const T& value)
+    {
+        T copy(value);
+        return TryPush(std::move(copy));
+    }
+
+    // Consumer side. Returns false if the queue is empty.
+    bool TryPop(T& value)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cachedTail)
+        {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail)
+            {
+                return false;
+            }
+        }
+        value = std::move(m_slots[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static size_t RoundUpToPowerOfTwo(size_t value)
+    {
+        size_t result = 1;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+private:
+    static const size_t s_cacheLine = 64;
+
+    std::vector<T> m_slots;
+    const size_t m_mask;
+    // Positions are never wrapped, the slot index is taken by the mask.
+    // Consumer's data is kept on its own cache line apart from the producer's one.
+    alignas(s_cacheLine) std::atomic<size_t> m_head;
+    size_t m_cachedTail;
+    alignas(s_cacheLine) std::atomic<size_t> m_tail;
+    size_t m_cachedHead;
+};
@@ -0,0 +1,86 @@
+// Latency of handing a line from one thread to another through SpscQueue.
+// It is disabled by default, run it with --gtest_also_run_disabled_tests.
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include "spscqueue.h"
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const size_t s_messages = 1000000;
+    const size_t s_buckets = 32; // Bucket i holds latencies in [2^i, 2^(i+1)) ns
+
+    size_t Bucket(Clock::duration latency)
+    {
+        auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count();
+        size_t bucket = 0;
+        while (nanoseconds > 1 && bucket + 1 < s_buckets)
+        {
+            nanoseconds >>= 1;
+            ++bucket;
+        }
+        return bucket;
+    }
+
+    // Upper bound of the bucket containing the given fraction of the samples
+    unsigned long long Percentile(const std::vector<size_t>& histogram, double fraction)
+    {
+        const size_t target = static_cast<size_t>(fraction * s_messages);
+        size_t seen = 0;
+        for (size_t bucket = 0; bucket < histogram.size(); ++bucket)
+        {
+            seen += histogram[bucket];
+            if (seen > target)
+            {
+                return 1ull << (bucket + 1);
+            }
+        }
+        return 1ull << s_buckets;
+    }
+}
+
+TEST(SpscQueueBenchmark, DISABLED_HandOffLatencyHistogram)
+{
+    SpscQueue<Clock::time_point> queue(1024);
+    std::vector<size_t> histogram(s_buckets);
+
+    std::thread consumer([&queue, &histogram]()
+    {
+        Clock::time_point sent;
+        for (size_t received = 0; received < s_messages;)
+        {
+            if (queue.TryPop(sent))
+            {
+                ++histogram[Bucket(Clock::now() - sent)];
+                ++received;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    for (size_t i = 0; i < s_messages; ++i)
+    {
+        while (!queue.TryPush(Clock::now()))
+        {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+
+    std::cout << "Hand-off latency, messages: " << s_messages << std::endl;
+    for (size_t bucket = 0; bucket < histogram.size(); ++bucket)
+    {
+        if (histogram[bucket])
+        {
+            std::cout << "  < " << (1ull << (bucket + 1)) << " ns: " << histogram[bucket] << std::endl;
+        }
+    }
+    std::cout << "p50 < " << Percentile(histogram, 0.5) << " ns, p99 < " << Percentile(histogram, 0.99)
+              << " ns, p99.9 < " << Percentile(histogram, 0.999) << " ns" << std::endl;
+}
@@ -0,0 +1,128 @@
+// Stress tests are meant to be run under ThreadSanitizer as well, build with `qmake CONFIG+=tsan` for it.
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include "spscqueue.h"
+
+TEST(SpscQueueTest, RoundsCapacityUpToPowerOfTwo)
+{
+    SpscQueue<int> queue(5);
+
+    EXPECT_EQ(8u, queue.Capacity());
+}
+
+TEST(SpscQueueTest, EmptyQueueHasNothingToPop)
+{
+    SpscQueue<int> queue(4);
+    int value = 0;
+
+    EXPECT_FALSE(queue.TryPop(value));
+}
+
+TEST(SpscQueueTest, PopsInOrderOfPushing)
+{
+    SpscQueue<std::string> queue(4);
+    queue.TryPush("first");
+    queue.TryPush("second");
+
+    std::string value;
+    ASSERT_TRUE(queue.TryPop(value));
+    EXPECT_EQ("first", value);
+    ASSERT_TRUE(queue.TryPop(value));
+    EXPECT_EQ("second", value);
+    EXPECT_FALSE(queue.TryPop(value));
+}
+
+TEST(SpscQueueTest, RejectsPushWhenFull)
+{
+    SpscQueue<std::string> queue(2);
+    ASSERT_TRUE(queue.TryPush("one"));
+    ASSERT_TRUE(queue.TryPush("two"));
+
+    std::string rejected("three");
+    EXPECT_FALSE(queue.TryPush(std::move(rejected)));
+    EXPECT_EQ("three", rejected);
+}
+
+TEST(SpscQueueTest, ReusesSlotsAfterPop)
+{
+    SpscQueue<int> queue(2);
+    int value = 0;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_TRUE(queue.TryPush(i));
+        ASSERT_TRUE(queue.TryPop(value));
+        EXPECT_EQ(i, value);
+    }
+}
+
+TEST(SpscQueueTest, StressKeepsOrderBetweenThreads)
+{
+    const size_t count = 1000000;
+    SpscQueue<size_t> queue(64);
+
+    std::thread producer([&queue, count]()
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            while (!queue.TryPush(i))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    size_t expected = 0;
+    size_t value = 0;
+    while (expected < count)
+    {
+        if (!queue.TryPop(value))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        if (value != expected)
+        {
+            break;
+        }
+        ++expected;
+    }
+    producer.join();
+
+    EXPECT_EQ(count, expected);
+}
+
+TEST(SpscQueueTest, StressDeliversLines)
+{
+    const size_t count = 100000;
+    SpscQueue<std::string> queue(16);
+
+    std::thread gui([&queue, count]()
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::string line = "line " + std::to_string(i);
+            while (!queue.TryPush(std::move(line)))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    size_t received = 0;
+    std::string line;
+    while (received < count)
+    {
+        if (queue.TryPop(line))
+        {
+            ASSERT_EQ("line " + std::to_string(received), line);
+            ++received;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    gui.join();
+}
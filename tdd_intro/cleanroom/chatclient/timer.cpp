@@ -0,0 +1,34 @@
+#include "timer.h"
+
+TimePoint SystemTime::GetCurrent()
+{
+    return Clock::now();
+}
+
+Timer::Timer(ITime& time, Duration duration)
+    : m_time(time)
+    , m_duration(duration)
+    , m_started(false)
+{
+}
+
+void Timer::Start()
+{
+    m_started = true;
+    m_startTime = m_time.GetCurrent();
+}
+
+bool Timer::IsExpired() const
+{
+    return !m_started || TimeElapsed() >= m_duration;
+}
+
+Duration Timer::TimeLeft() const
+{
+    return IsExpired() ? Duration::zero() : m_duration - TimeElapsed();
+}
+
+Duration Timer::TimeElapsed() const
+{
+    return m_time.GetCurrent() - m_startTime;
+}
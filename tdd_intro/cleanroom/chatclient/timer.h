@@ -0,0 +1,30 @@
+#pragma once
+#include "itimer.h"
+
+// Current time of the system clock.
+class SystemTime : public ITime
+{
+public:
+    TimePoint GetCurrent() override;
+};
+
+// Timer, which expires when the duration passes since Start.
+// It is expired if not started, and can be started again any time.
+class Timer : public ITimer
+{
+public:
+    Timer(ITime& time, Duration duration);
+
+    void Start() override;
+    bool IsExpired() const override;
+    Duration TimeLeft() const override;
+
+private:
+    Duration TimeElapsed() const;
+
+private:
+    ITime& m_time;
+    Duration m_duration;
+    bool m_started;
+    TimePoint m_startTime;
+};
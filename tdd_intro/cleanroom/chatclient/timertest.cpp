@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include "timer.h"
+#include "mocks.h"
+
+using namespace std::chrono_literals;
+
+TEST(TimerTest, ExpiredWhenNotStarted)
+{
+    TimeFake time;
+    Timer timer(time, 2ms);
+
+    EXPECT_TRUE(timer.IsExpired());
+    EXPECT_EQ(Duration::zero(), timer.TimeLeft());
+}
+
+TEST(TimerTest, ExpiresAfterDuration)
+{
+    TimeFake time;
+    Timer timer(time, 2ms);
+
+    timer.Start();
+    time.Wait(1ms);
+    EXPECT_FALSE(timer.IsExpired());
+    EXPECT_EQ(Duration(1ms), timer.TimeLeft());
+
+    time.Wait(1ms);
+    EXPECT_TRUE(timer.IsExpired());
+    EXPECT_EQ(Duration::zero(), timer.TimeLeft());
+}
+
+TEST(TimerTest, RestartsFromCurrentTime)
+{
+    TimeFake time;
+    Timer timer(time, 2ms);
+
+    timer.Start();
+    time.Wait(3ms);
+    timer.Start();
+
+    EXPECT_FALSE(timer.IsExpired());
+    EXPECT_EQ(Duration(2ms), timer.TimeLeft());
+}
@@ -0,0 +1,83 @@
+#include "transmitbatcher.h"
+
+TransmitBatcher::TransmitBatcher(ISocketWrapper& socket, ITimer& deadline, size_t flushSize)
+    : m_socket(socket)
+    , m_deadline(deadline)
+    , m_flushSize(flushSize)
+    , m_framing(MessageFramer::Framing::Terminated)
+    , m_recorder(nullptr)
+{
+    m_batch.reserve(flushSize);
+}
+
+void TransmitBatcher::SetFraming(MessageFramer::Framing framing)
+{
+    m_framing = framing;
+}
+
+void TransmitBatcher::SetRecorder(LatencyRecorder* recorder)
+{
+    m_recorder = recorder;
+}
+
+void TransmitBatcher::Write(std::string_view message)
+{
+    {
+        LatencyRecorder::Span span(m_recorder, LatencyRecorder::Stage::Frame);
+        Append(message);
+    }
+    if (m_batch.size() >= m_flushSize)
+    {
+        Flush();
+    }
+}
+
+void TransmitBatcher::Append(std::string_view message)
+{
+    if (m_batch.empty())
+    {
+        m_deadline.Start();
+    }
+    if (m_framing == MessageFramer::Framing::LengthPrefixed)
+    {
+        char prefix[MessageFramer::s_maxPrefixSize];
+        m_batch.append(prefix, MessageFramer::EncodeLength(message.size(), prefix));
+        m_batch.append(message.data(), message.size());
+    }
+    else
+    {
+        m_batch.append(message.data(), message.size());
+        m_batch.push_back('\0');
+    }
+}
+
+bool TransmitBatcher::Poll()
+{
+    if (m_batch.empty() || !m_deadline.IsExpired())
+    {
+        return false;
+    }
+    Flush();
+    return true;
+}
+
+void TransmitBatcher::Flush()
+{
+    if (m_batch.empty())
+    {
+        return;
+    }
+    LatencyRecorder::Span span(m_recorder, LatencyRecorder::Stage::Send);
+    m_socket.Write(m_batch);
+    m_batch.clear(); // Keeps the capacity for the next batch
+}
+
+Duration TransmitBatcher::TimeLeft() const
+{
+    return m_batch.empty() ? Duration::zero() : m_deadline.TimeLeft();
+}
+
+size_t TransmitBatcher::GetBatchedSize() const
+{
+    return m_batch.size();
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include "isocketwrapper.h"
+#include "itimer.h"
+#include "latencyrecorder.h"
+#include "messageframer.h"
+
+/*
+ * Opt-in batching of outgoing chat messages, so a burst of short lines goes out with one send.
+ *
+ * Messages are framed with the '\0' terminator, or the length prefix once it is negotiated, and collected in one buffer, which is sent when:
+ *   * its size reaches the flush threshold;
+ *   * the deadline timer, started by the first message of the batch, expires (see Poll);
+ *   * Flush is called explicitly, before waiting for the user input for example.
+ * So a message waits not longer than the deadline, and the socket should have TCP_NODELAY set
+ * not to add the Nagle delay on top of it.
+ *
+ * Exceptions of ISocketWrapper are passed through.
+*/
+
+class TransmitBatcher
+{
+public:
+    static const size_t s_defaultFlushSize = 16 * 1024;
+
+    // Deadline timer is given with its duration already set.
+    TransmitBatcher(ISocketWrapper& socket, ITimer& deadline, size_t flushSize = s_defaultFlushSize);
+
+    // Framing of the messages written from now on, Terminated by default.
+    void SetFraming(MessageFramer::Framing framing);
+    // Measures Frame and Send stages from now on, null turns it off.
+    void SetRecorder(LatencyRecorder* recorder);
+
+    // Adds the message to the batch, sends the batch if it reached the flush threshold.
+    void Write(std::string_view message);
+    // Sends the batch if its deadline expired. The client loop calls it not later than TimeLeft().
+    // Returns true if the batch is sent.
+    bool Poll();
+    // Sends the batch right away.
+    void Flush();
+
+    // Time till the batch must be sent, zero if there is nothing to send.
+    Duration TimeLeft() const;
+    size_t GetBatchedSize() const;
+
+private:
+    void Append(std::string_view message);
+
+private:
+    ISocketWrapper& m_socket;
+    ITimer& m_deadline;
+    const size_t m_flushSize;
+    MessageFramer::Framing m_framing;
+    LatencyRecorder* m_recorder;
+    std::string m_batch;
+};
@@ -0,0 +1,142 @@
+// Send system calls per message and latency added by TransmitBatcher over loopback,
+// for the bursts of short chat messages.
+// It is disabled by default, run it with --gtest_also_run_disabled_tests.
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+#include "transmitbatcher.h"
+#include "socketwrapper.h"
+#include "timer.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    const char* s_address = "127.0.0.1";
+    const int16_t s_port = 4450;
+    const size_t s_messages = 50000;
+
+    // Passes everything to the real socket, counting the send calls
+    class SendCounter : public ISocketWrapper
+    {
+    public:
+        explicit SendCounter(ISocketWrapper& socket) : m_socket(socket), m_sends(0) { }
+
+        void Bind(const std::string& addr, int16_t port) override { m_socket.Bind(addr, port); }
+        void Listen() override { m_socket.Listen(); }
+        ISocketWrapperPtr Accept() override { return m_socket.Accept(); }
+        ISocketWrapperPtr Connect(const std::string& addr, int16_t port) override { return m_socket.Connect(addr, port); }
+        ISocketWrapperPtr TryConnect(const std::string& addr, int16_t port) override { return m_socket.TryConnect(addr, port); }
+        ISocketWrapperPtr FinishConnect() override { return m_socket.FinishConnect(); }
+        void Read(std::string& buffer) override { m_socket.Read(buffer); }
+        size_t Read(char* buffer, size_t size) override { return m_socket.Read(buffer, size); }
+        void Write(const std::string& buffer) override { ++m_sends; m_socket.Write(buffer); }
+        void WriteV(const ConstBuffer* buffers, size_t count) override { ++m_sends; m_socket.WriteV(buffers, count); }
+        size_t TryWriteV(const ConstBuffer* buffers, size_t count) override { ++m_sends; return m_socket.TryWriteV(buffers, count); }
+
+        size_t GetSends() const { return m_sends; }
+
+    private:
+        ISocketWrapper& m_socket;
+        size_t m_sends;
+    };
+
+    // Runs the user typing in bursts: several lines one after another, then a pause.
+    // Prints send calls per message and the percentiles of the time messages wait in the batch.
+    void Measure(const char* name, bool batched, Duration deadlineDuration, size_t flushSize)
+    {
+        SocketWrapper listener;
+        listener.Bind(s_address, s_port);
+        listener.Listen();
+        std::thread reader([]()
+        {
+            SocketWrapper client;
+            auto connection = client.Connect(s_address, s_port);
+            char buffer[64 * 1024];
+            while (connection->Read(buffer, sizeof(buffer)) > 0)
+            {
+            }
+        });
+
+        std::vector<Duration> waits;
+        waits.reserve(s_messages);
+        size_t sends = 0;
+        {
+            auto server = listener.Accept();
+            SendCounter socket(*server);
+            SystemTime time;
+            Timer deadline(time, deadlineDuration);
+            TransmitBatcher batcher(socket, deadline, flushSize);
+
+            std::mt19937 random(42);
+            std::uniform_int_distribution<size_t> burst(1, 8);
+            std::uniform_int_distribution<int> pause(0, 200);
+            const std::string message(40, 'x');
+            const std::string framed = message + '\0';
+            std::vector<TimePoint> pending;
+
+            auto onSent = [&]()
+            {
+                const TimePoint now = Clock::now();
+                for (const TimePoint& written : pending)
+                {
+                    waits.push_back(now - written);
+                }
+                pending.clear();
+            };
+
+            for (size_t sent = 0; sent < s_messages;)
+            {
+                for (size_t i = burst(random); i > 0 && sent < s_messages; --i, ++sent)
+                {
+                    if (!batched)
+                    {
+                        socket.Write(framed);
+                        waits.push_back(Duration::zero());
+                        continue;
+                    }
+                    pending.push_back(Clock::now());
+                    batcher.Write(message);
+                    if (batcher.GetBatchedSize() == 0)
+                    {
+                        onSent();
+                    }
+                }
+                // Client loop polls while waiting for the next input
+                const TimePoint until = Clock::now() + std::chrono::microseconds(pause(random));
+                while (Clock::now() < until)
+                {
+                    if (batcher.Poll())
+                    {
+                        onSent();
+                    }
+                }
+            }
+            batcher.Flush();
+            onSent();
+            sends = socket.GetSends();
+        }
+        reader.join();
+
+        std::sort(waits.begin(), waits.end());
+        auto percentile = [&waits](double p)
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(waits[static_cast<size_t>(p * (waits.size() - 1))]).count();
+        };
+        std::cout << name << ": " << static_cast<double>(sends) / s_messages << " sends/message"
+                  << ", added latency p50 " << percentile(0.5) << " us, p99 " << percentile(0.99)
+                  << " us, max " << percentile(1.0) << " us" << std::endl;
+    }
+}
+
+TEST(TransmitBatcherBenchmark, DISABLED_SendsPerMessageAndAddedLatency)
+{
+    Measure("Unbatched", false, Duration::zero(), 0);
+    Measure("Batched, deadline 50 us", true, 50us, TransmitBatcher::s_defaultFlushSize);
+    Measure("Batched, deadline 200 us", true, 200us, TransmitBatcher::s_defaultFlushSize);
+    Measure("Batched, deadline 200 us, flush at 128 bytes", true, 200us, 128);
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include "transmitbatcher.h"
+#include "timer.h"
+#include "mocks.h"
+
+using namespace std::chrono_literals;
+
+TEST(TransmitBatcherTest, KeepsSmallMessagesUntilDeadline)
+{
+    SocketWrapperMock socket;
+    TimeFake time;
+    Timer deadline(time, 1ms);
+    TransmitBatcher batcher(socket, deadline);
+
+    EXPECT_CALL(socket, Write(testing::_)).Times(0);
+    batcher.Write("Hello!");
+    batcher.Write("How are you?");
+
+    EXPECT_FALSE(batcher.Poll());
+    EXPECT_EQ(20u, batcher.GetBatchedSize());
+}
+
+TEST(TransmitBatcherTest, SendsBatchOnceDeadlineExpires)
+{
+    SocketWrapperMock socket;
+    TimeFake time;
+    Timer deadline(time, 1ms);
+    TransmitBatcher batcher(socket, deadline);
+
+    batcher.Write("Hello!");
+    time.Wait(500us);
+    batcher.Write("How are you?");
+    time.Wait(500us);
+
+    EXPECT_CALL(socket, Write(std::string("Hello!\0How are you?\0", 20))).Times(1);
+    EXPECT_TRUE(batcher.Poll());
+    EXPECT_EQ(0u, batcher.GetBatchedSize());
+}
+
+TEST(TransmitBatcherTest, DeadlineStartsWithFirstMessageOfBatch)
+{
+    SocketStreamFake socket("");
+    TimeFake time;
+    Timer deadline(time, 1ms);
+    TransmitBatcher batcher(socket, deadline);
+
+    time.Wait(5ms);
+    batcher.Write("Hello!");
+
+    EXPECT_FALSE(batcher.Poll());
+    EXPECT_EQ(Duration(1ms), batcher.TimeLeft());
+}
+
+TEST(TransmitBatcherTest, SendsBatchReachingFlushSize)
+{
+    SocketStreamFake socket("");
+    TimeFake time;
+    Timer deadline(time, 1ms);
+    TransmitBatcher batcher(socket, deadline, 10);
+
+    batcher.Write("Hello");
+    EXPECT_EQ("", socket.Written());
+
+    batcher.Write("Bob!");
+    EXPECT_EQ(std::string("Hello\0Bob!\0", 11), socket.Written());
+    EXPECT_EQ(Duration::zero(), batcher.TimeLeft());
+}
+
+TEST(TransmitBatcherTest, FlushSendsRightAway)
+{
+    SocketStreamFake socket("");
+    TimeFake time;
+    Timer deadline(time, 1ms);
+    TransmitBatcher batcher(socket, deadline);
+
+    batcher.Write("Hello!");
+    batcher.Flush();
+
+    EXPECT_EQ(std::string("Hello!\0", 7), socket.Written());
+    EXPECT_FALSE(batcher.Poll());
+}
+
+TEST(TransmitBatcherTest, NothingToSendWithoutMessages)
+{
+    SocketWrapperMock socket;
+    TimeFake time;
+    Timer deadline(time, 1ms);
+    TransmitBatcher batcher(socket, deadline);
+
+    EXPECT_CALL(socket, Write(testing::_)).Times(0);
+    time.Wait(5ms);
+    EXPECT_FALSE(batcher.Poll());
+    batcher.Flush();
+}
+
+TEST(TransmitBatcherTest, PrefixesMessagesWithLengthInV2Framing)
+{
+    SocketStreamFake socket("");
+    TimeFake time;
+    Timer deadline(time, 1ms);
+    TransmitBatcher batcher(socket, deadline);
+    batcher.SetFraming(MessageFramer::Framing::LengthPrefixed);
+
+    batcher.Write(std::string("a\0b", 3));
+    batcher.Write("Hello!");
+    batcher.Flush();
+
+    EXPECT_EQ(std::string("\x03" "a\0b" "\x06" "Hello!", 11), socket.Written());
+}
+
+TEST(TransmitBatcherTest, MeasuresFrameAndSendStages)
+{
+    SocketStreamFake socket("");
+    TimeFake time;
+    Timer deadline(time, 1ms);
+    LatencyRecorder recorder(time);
+    TransmitBatcher batcher(socket, deadline);
+    batcher.SetRecorder(&recorder);
+
+    batcher.Write("Hello!");
+    batcher.Write("Bye!");
+    batcher.Flush();
+
+    EXPECT_EQ(2u, recorder.GetHistogram(LatencyRecorder::Stage::Frame).GetCount());
+    EXPECT_EQ(1u, recorder.GetHistogram(LatencyRecorder::Stage::Send).GetCount());
+}
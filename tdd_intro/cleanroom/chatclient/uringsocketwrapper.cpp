@@ -0,0 +1,442 @@
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+#include "uringsocketwrapper.h"
+#include "slaballocator.h"
+#include "socketwrapper.h"
+
+namespace
+{
+    const size_t s_maxWriteVectors = 64; // Buffers gathered by one sendmsg operation
+
+    std::string GetExceptionString(const std::string& message, int errorCode)
+    {
+        return message + " " + std::to_string(errorCode) + " " + std::strerror(errorCode) + "\n";
+    }
+
+    sockaddr_in MakeAddress(const std::string& addr, int16_t port)
+    {
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = inet_addr(addr.data());
+        address.sin_port = htons(static_cast<uint16_t>(port));
+        return address;
+    }
+
+    // Cancels the operation and waits until the kernel is done with it
+    void CancelAndReap(IoUring& ring, IoUring::Operation& operation)
+    {
+        try
+        {
+            IoUring::Operation cancel;
+            io_uring_sqe& entry = ring.Prepare(cancel);
+            entry.opcode = IORING_OP_ASYNC_CANCEL;
+            entry.addr = reinterpret_cast<uint64_t>(&operation);
+            while (!operation.IsDone() || !cancel.IsDone())
+            {
+                ring.WaitAny();
+            }
+        }
+        catch (...)
+        {
+            // Kernel may still write to the operation and the caller's buffers, there is no safe way to unwind
+            std::terminate();
+        }
+    }
+
+    // Returns result of the operation, which is prepared by the given function
+    template <typename PrepareFunction>
+    int Execute(IoUring& ring, PrepareFunction prepare)
+    {
+        IoUring::Operation operation;
+        prepare(ring.Prepare(operation));
+        try
+        {
+            ring.Wait(operation);
+        }
+        catch (const std::exception&)
+        {
+            // Operation and the buffers it uses are on the caller's stack, so it must be finished before unwinding
+            CancelAndReap(ring, operation);
+            throw;
+        }
+        return operation.GetResult();
+    }
+}
+
+UringSocketWrapper::AcceptQueue::AcceptQueue()
+    : armed(false)
+    , multishot(true)
+    , error(0)
+{
+}
+
+void UringSocketWrapper::AcceptQueue::OnComplete(int result, uint32_t flags)
+{
+    if (result >= 0)
+    {
+        connections.push_back(result);
+    }
+    else if (result != -ECANCELED)
+    {
+        error = -result;
+    }
+    if (!(flags & IORING_CQE_F_MORE))
+    {
+        armed = false;
+    }
+}
+
+UringSocketWrapper::UringSocketWrapper()
+    : UringSocketWrapper(IoUring::ThreadDefault())
+{
+}
+
+UringSocketWrapper::UringSocketWrapper(IoUring& ring)
+    : m_socket(socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, IPPROTO_TCP))
+    , m_ring(ring)
+    , m_owner(std::this_thread::get_id())
+{
+    if (m_socket == -1)
+    {
+        throw std::runtime_error(GetExceptionString("Failed to create socket to listen on.", errno));
+    }
+}
+
+UringSocketWrapper::UringSocketWrapper(int other, IoUring& ring)
+    : m_socket(other)
+    , m_ring(ring)
+    , m_owner(std::this_thread::get_id())
+{
+    int noDelay = 1;
+    setsockopt(m_socket, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+}
+
+UringSocketWrapper::~UringSocketWrapper()
+{
+    if (m_accepted)
+    {
+        CancelAccept();
+    }
+    if (m_accepted)
+    {
+        for (int connection : m_accepted->connections)
+        {
+            close(connection);
+        }
+    }
+    close(m_socket);
+}
+
+void UringSocketWrapper::Bind(const std::string& addr, int16_t port)
+{
+    // Allows to rebind the port right after the previous listener is closed
+    int reuse = 1;
+    setsockopt(m_socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address = MakeAddress(addr, port);
+    if (bind(m_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
+    {
+        throw std::runtime_error(GetExceptionString("Failed to bind socket to address.", errno));
+    }
+}
+
+void UringSocketWrapper::Listen()
+{
+    if (listen(m_socket, SOMAXCONN) == -1)
+    {
+        throw std::runtime_error(GetExceptionString("Failed to listen on socket.", errno));
+    }
+}
+
+ISocketWrapperPtr UringSocketWrapper::Accept()
+{
+    CheckThread();
+    if (!m_accepted)
+    {
+        m_accepted.reset(new AcceptQueue);
+    }
+
+    while (m_accepted->connections.empty())
+    {
+        if (m_accepted->error)
+        {
+            const int error = m_accepted->error;
+            m_accepted->error = 0;
+            if (error == EINVAL && m_accepted->multishot)
+            {
+                m_accepted->multishot = false; // Kernels before 5.19, accept one by one
+                continue;
+            }
+            throw std::runtime_error(GetExceptionString("Failed to connect to client.", error));
+        }
+        if (!m_accepted->armed)
+        {
+            ArmAccept();
+        }
+        m_ring.WaitAny();
+    }
+
+    int other = m_accepted->connections.front();
+    m_accepted->connections.pop_front();
+    return std::allocate_shared<UringSocketWrapper>(SlabAllocator<UringSocketWrapper>(), other, m_ring);
+}
+
+ISocketWrapperPtr UringSocketWrapper::Connect(const std::string& addr, int16_t port)
+{
+    CheckThread();
+    sockaddr_in address = MakeAddress(addr, port);
+    int result = Execute(m_ring, [this, &address](io_uring_sqe& entry)
+    {
+        entry.opcode = IORING_OP_CONNECT;
+        entry.fd = m_socket;
+        entry.addr = reinterpret_cast<uint64_t>(&address);
+        entry.off = sizeof(address);
+    });
+    if (result < 0)
+    {
+        throw std::runtime_error(GetExceptionString("Failed to connect to server.", -result));
+    }
+
+    // This socket is connected now, the returned one shares the same connection
+    int other = dup(m_socket);
+    if (other == -1)
+    {
+        throw std::runtime_error(GetExceptionString("Failed to duplicate connected socket.", errno));
+    }
+    return std::allocate_shared<UringSocketWrapper>(SlabAllocator<UringSocketWrapper>(), other, m_ring);
+}
+
+ISocketWrapperPtr UringSocketWrapper::TryConnect(const std::string& addr, int16_t port)
+{
+    // Operations of the ring complete before returning, there is no readiness to wait for
+    return Connect(addr, port);
+}
+
+ISocketWrapperPtr UringSocketWrapper::FinishConnect()
+{
+    throw std::logic_error("Connection is never in progress for the io_uring socket.");
+}
+
+void UringSocketWrapper::Read(std::string& buffer)
+{
+    CheckThread();
+    const int index = m_ring.AcquireBuffer();
+    if (index == -1)
+    {
+        buffer.resize(IoUring::s_poolBufferSize); // Reuses capacity of the caller's buffer
+        buffer.resize(Read(&buffer[0], buffer.size()));
+        return;
+    }
+
+    char* registered = m_ring.GetBuffer(index);
+    int result = Execute(m_ring, [this, index, registered](io_uring_sqe& entry)
+    {
+        entry.opcode = IORING_OP_READ_FIXED;
+        entry.fd = m_socket;
+        entry.addr = reinterpret_cast<uint64_t>(registered);
+        entry.len = IoUring::s_poolBufferSize;
+        entry.buf_index = static_cast<uint16_t>(index);
+    });
+    if (result >= 0)
+    {
+        buffer.assign(registered, static_cast<size_t>(result));
+    }
+    m_ring.ReleaseBuffer(index);
+
+    if (result < 0)
+    {
+        throw std::runtime_error(GetExceptionString("Failed to read data.", -result));
+    }
+}
+
+size_t UringSocketWrapper::Read(char* buffer, size_t size)
+{
+    CheckThread();
+    int result = Execute(m_ring, [this, buffer, size](io_uring_sqe& entry)
+    {
+        entry.opcode = IORING_OP_RECV;
+        entry.fd = m_socket;
+        entry.addr = reinterpret_cast<uint64_t>(buffer);
+        entry.len = static_cast<uint32_t>(std::min<size_t>(size, UINT32_MAX));
+    });
+    if (result < 0)
+    {
+        throw std::runtime_error(GetExceptionString("Failed to read data.", -result));
+    }
+    return static_cast<size_t>(result);
+}
+
+void UringSocketWrapper::Write(const std::string& buffer)
+{
+    CheckThread();
+    for (size_t dataSent = 0; dataSent < buffer.size();)
+    {
+        // MSG_WAITALL makes the kernel send the rest itself after a partial send
+        int result = Execute(m_ring, [this, &buffer, dataSent](io_uring_sqe& entry)
+        {
+            entry.opcode = IORING_OP_SEND;
+            entry.fd = m_socket;
+            entry.addr = reinterpret_cast<uint64_t>(buffer.data() + dataSent);
+            entry.len = static_cast<uint32_t>(std::min<size_t>(buffer.size() - dataSent, UINT32_MAX));
+            entry.msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+        });
+        if (result < 0)
+        {
+            throw std::runtime_error(GetExceptionString("Failed to send data.", -result));
+        }
+        dataSent += static_cast<size_t>(result);
+    }
+}
+
+void UringSocketWrapper::WriteV(const ConstBuffer* buffers, size_t count)
+{
+    CheckThread();
+    iovec vectors[s_maxWriteVectors];
+    while (count > 0)
+    {
+        size_t pendingCount = std::min(count, s_maxWriteVectors);
+        for (size_t i = 0; i < pendingCount; ++i)
+        {
+            vectors[i].iov_base = const_cast<char*>(buffers[i].data);
+            vectors[i].iov_len = buffers[i].size;
+        }
+        buffers += pendingCount;
+        count -= pendingCount;
+
+        iovec* pending = vectors;
+        while (pendingCount > 0)
+        {
+            msghdr message = {};
+            message.msg_iov = pending;
+            message.msg_iovlen = pendingCount;
+            int result = Execute(m_ring, [this, &message](io_uring_sqe& entry)
+            {
+                entry.opcode = IORING_OP_SENDMSG;
+                entry.fd = m_socket;
+                entry.addr = reinterpret_cast<uint64_t>(&message);
+                entry.len = 1;
+                entry.msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+            });
+            if (result < 0)
+            {
+                throw std::runtime_error(GetExceptionString("Failed to send data.", -result));
+            }
+
+            // Skips fully sent buffers and moves the beginning of partially sent one
+            size_t dataSent = static_cast<size_t>(result);
+            while (pendingCount > 0 && dataSent >= pending->iov_len)
+            {
+                dataSent -= pending->iov_len;
+                ++pending;
+                --pendingCount;
+            }
+            if (pendingCount > 0)
+            {
+                pending->iov_base = static_cast<char*>(pending->iov_base) + dataSent;
+                pending->iov_len -= dataSent;
+            }
+        }
+    }
+}
+
+size_t UringSocketWrapper::TryWriteV(const ConstBuffer* buffers, size_t count)
+{
+    CheckThread();
+    iovec vectors[s_maxWriteVectors];
+    const size_t vectorCount = std::min(count, s_maxWriteVectors);
+    for (size_t i = 0; i < vectorCount; ++i)
+    {
+        vectors[i].iov_base = const_cast<char*>(buffers[i].data);
+        vectors[i].iov_len = buffers[i].size;
+    }
+
+    msghdr message = {};
+    message.msg_iov = vectors;
+    message.msg_iovlen = vectorCount;
+    // With MSG_DONTWAIT the operation completes with EAGAIN instead of waiting for the socket
+    int result = Execute(m_ring, [this, &message](io_uring_sqe& entry)
+    {
+        entry.opcode = IORING_OP_SENDMSG;
+        entry.fd = m_socket;
+        entry.addr = reinterpret_cast<uint64_t>(&message);
+        entry.len = 1;
+        entry.msg_flags = MSG_NOSIGNAL | MSG_DONTWAIT;
+    });
+    if (result == -EAGAIN)
+    {
+        return 0;
+    }
+    if (result < 0)
+    {
+        throw std::runtime_error(GetExceptionString("Failed to send data.", -result));
+    }
+    return static_cast<size_t>(result);
+}
+
+int UringSocketWrapper::Handle() const
+{
+    return m_socket;
+}
+
+void UringSocketWrapper::CheckThread() const
+{
+    if (std::this_thread::get_id() != m_owner)
+    {
+        throw std::logic_error("Socket is used by a thread other than the one which created it.");
+    }
+}
+
+void UringSocketWrapper::ArmAccept()
+{
+    io_uring_sqe& entry = m_ring.Prepare(*m_accepted);
+    entry.opcode = IORING_OP_ACCEPT;
+    entry.fd = m_socket;
+    entry.accept_flags = SOCK_CLOEXEC;
+    entry.ioprio = m_accepted->multishot ? IORING_ACCEPT_MULTISHOT : 0;
+    m_accepted->armed = true;
+}
+
+void UringSocketWrapper::CancelAccept()
+{
+    if (!m_accepted->armed)
+    {
+        return;
+    }
+
+    try
+    {
+        IoUring::Operation cancel;
+        io_uring_sqe& entry = m_ring.Prepare(cancel);
+        entry.opcode = IORING_OP_ASYNC_CANCEL;
+        entry.addr = reinterpret_cast<uint64_t>(m_accepted.get());
+        while (m_accepted->armed || !cancel.IsDone())
+        {
+            m_ring.WaitAny();
+        }
+    }
+    catch (const std::exception&)
+    {
+        // Kernel may still complete the accept into the queue, so it is never freed
+        m_accepted.release();
+    }
+}
+
+ISocketWrapperPtr CreateSocketWrapper()
+{
+    static const bool s_uringSupported = IoUring::IsSupported();
+    if (s_uringSupported)
+    {
+        return std::make_shared<UringSocketWrapper>();
+    }
+    return std::make_shared<SocketWrapper>();
+}
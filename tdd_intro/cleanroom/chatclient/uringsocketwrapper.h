@@ -0,0 +1,69 @@
+#pragma once
+#include <deque>
+#include <memory>
+#include <thread>
+#include "iouring.h"
+#include "isocketwrapper.h"
+
+/*
+ * Linux io_uring implementation of ISocketWrapper.
+ *
+ * Every blocking call prepares its operation in the ring and waits for it with one io_uring_enter,
+ * which also submits everything prepared before, so no separate readiness wait is needed.
+ * Read(std::string&) receives into the buffers registered in the ring once.
+ * Listener arms a multishot accept on the first Accept: the kernel keeps accepting
+ * the connections, which are returned by the following Accept calls without a new submission.
+ * Unless the ring is given explicitly, the one of the thread creating the socket is used.
+ * The ring is not thread-safe, so the socket must be used only by the thread which created it
+ * (accepted and connected sockets belong to the thread of Accept or Connect), other threads get std::logic_error.
+*/
+
+class UringSocketWrapper : public ISocketWrapper
+{
+public:
+    UringSocketWrapper();
+    explicit UringSocketWrapper(IoUring& ring);
+    UringSocketWrapper(int other, IoUring& ring);
+    ~UringSocketWrapper();
+    void Bind(const std::string& addr, int16_t port);
+    void Listen();
+    ISocketWrapperPtr Accept();
+    ISocketWrapperPtr Connect(const std::string& addr, int16_t port);
+    ISocketWrapperPtr TryConnect(const std::string& addr, int16_t port);
+    ISocketWrapperPtr FinishConnect();
+    void Read(std::string& buffer);
+    size_t Read(char* buffer, size_t size);
+    void Write(const std::string& buffer);
+    void WriteV(const ConstBuffer* buffers, size_t count);
+    size_t TryWriteV(const ConstBuffer* buffers, size_t count);
+
+    int Handle() const;
+
+private:
+    // Connections delivered by the accept operation, which may stay armed between Accept calls
+    class AcceptQueue : public IoUring::Completion
+    {
+    public:
+        AcceptQueue();
+        void OnComplete(int result, uint32_t flags) override;
+
+        bool armed;
+        bool multishot; // Cleared if the kernel doesn't support multishot accept
+        int error;
+        std::deque<int> connections;
+    };
+
+    // Throws if the socket is used by a thread other than its owner
+    void CheckThread() const;
+    void ArmAccept();
+    void CancelAccept();
+
+private:
+    int m_socket;
+    IoUring& m_ring;
+    const std::thread::id m_owner;
+    std::unique_ptr<AcceptQueue> m_accepted;
+};
+
+// Creates io_uring socket when the kernel supports it, falls back to the epoll SocketWrapper otherwise.
+ISocketWrapperPtr CreateSocketWrapper();
@@ -0,0 +1,103 @@
+// Compares io_uring and epoll SocketWrapper implementations over loopback.
+// It is disabled by default, run it with --gtest_also_run_disabled_tests.
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include "socketwrapper.h"
+#include "uringsocketwrapper.h"
+
+namespace
+{
+    const char* s_address = "127.0.0.1";
+    const int16_t s_port = 4447;
+    const size_t s_roundTrips = 50000;
+    const size_t s_transferSize = 256 * 1024 * 1024; // 256MB
+    const size_t s_chunkSize = 64 * 1024;
+
+    // Each side of the connection is created by the thread using it, so it gets the thread's ring or reactor
+    template <typename Socket>
+    void MeasurePingPong(const std::string& name)
+    {
+        Socket listener;
+        listener.Bind(s_address, s_port);
+        listener.Listen();
+
+        std::thread echo([]()
+        {
+            Socket client;
+            auto connection = client.Connect(s_address, s_port);
+            char buffer[64];
+            while (size_t received = connection->Read(buffer, sizeof(buffer)))
+            {
+                connection->Write(std::string(buffer, received));
+            }
+        });
+        auto server = listener.Accept();
+
+        const std::string message("ping\0", 5);
+        char buffer[64];
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < s_roundTrips; ++i)
+        {
+            server->Write(message);
+            for (size_t received = 0; received < message.size();)
+            {
+                received += server->Read(buffer, sizeof(buffer));
+            }
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        server.reset();
+        echo.join();
+
+        std::cout << name << ": " << s_roundTrips / seconds << " round trips/s" << std::endl;
+    }
+
+    template <typename Socket>
+    void MeasureThroughput(const std::string& name)
+    {
+        Socket listener;
+        listener.Bind(s_address, s_port);
+        listener.Listen();
+
+        std::thread writer([]()
+        {
+            Socket client;
+            auto connection = client.Connect(s_address, s_port);
+            const std::string chunk(s_chunkSize, 'x');
+            for (size_t sent = 0; sent < s_transferSize; sent += chunk.size())
+            {
+                connection->Write(chunk);
+            }
+        });
+        auto server = listener.Accept();
+
+        std::string buffer;
+        size_t received = 0;
+        auto start = std::chrono::steady_clock::now();
+        while (received < s_transferSize)
+        {
+            server->Read(buffer);
+            ASSERT_FALSE(buffer.empty());
+            received += buffer.size();
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        writer.join();
+
+        std::cout << name << ": " << received / seconds / (1024 * 1024) << " MB/s" << std::endl;
+    }
+}
+
+TEST(UringSocketWrapperBenchmark, DISABLED_PingPong)
+{
+    ASSERT_TRUE(IoUring::IsSupported());
+    MeasurePingPong<SocketWrapper>("epoll");
+    MeasurePingPong<UringSocketWrapper>("io_uring");
+}
+
+TEST(UringSocketWrapperBenchmark, DISABLED_Throughput)
+{
+    ASSERT_TRUE(IoUring::IsSupported());
+    MeasureThroughput<SocketWrapper>("epoll");
+    MeasureThroughput<UringSocketWrapper>("io_uring");
+}
@@ -0,0 +1,180 @@
+// Tests for the io_uring SocketWrapper implementation (Linux only).
+// They are skipped if the kernel doesn't allow io_uring.
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+#include "uringsocketwrapper.h"
+
+namespace
+{
+    const char* s_address = "127.0.0.1";
+    const int16_t s_port = 4444;
+}
+
+TEST(UringSocketWrapperTest, EstablishConnection)
+{
+    if (!IoUring::IsSupported())
+    {
+        GTEST_SKIP() << "io_uring is not allowed by the kernel";
+    }
+    UringSocketWrapper listener;
+    UringSocketWrapper client;
+
+    listener.Bind(s_address, s_port);
+    listener.Listen();
+    client.Connect(s_address, s_port);
+    auto server = listener.Accept();
+
+    const char* testPhrase = "bla-bla-bla";
+
+    server->Write(testPhrase);
+    std::string str;
+    client.Read(str);
+
+    EXPECT_STREQ(testPhrase, str.c_str());
+}
+
+TEST(UringSocketWrapperTest, ReadIntoCallerBuffer)
+{
+    if (!IoUring::IsSupported())
+    {
+        GTEST_SKIP() << "io_uring is not allowed by the kernel";
+    }
+    UringSocketWrapper listener;
+    UringSocketWrapper client;
+
+    listener.Bind(s_address, s_port);
+    listener.Listen();
+    client.Connect(s_address, s_port);
+    auto server = listener.Accept();
+
+    const std::string testPhrase = "bla-bla-bla";
+
+    server->Write(testPhrase);
+    char buffer[64] = {};
+    size_t received = client.Read(buffer, sizeof(buffer));
+
+    EXPECT_EQ(testPhrase, std::string(buffer, received));
+}
+
+TEST(UringSocketWrapperTest, WriteGathersBuffers)
+{
+    if (!IoUring::IsSupported())
+    {
+        GTEST_SKIP() << "io_uring is not allowed by the kernel";
+    }
+    UringSocketWrapper listener;
+    UringSocketWrapper client;
+
+    listener.Bind(s_address, s_port);
+    listener.Listen();
+    client.Connect(s_address, s_port);
+    auto server = listener.Accept();
+
+    const std::string nickname = "metizik";
+    const std::string message = "Hello!";
+    const ConstBuffer buffers[] = { { nickname.data(), nickname.size() },
+                                    { ":", 1 },
+                                    { message.data(), message.size() + 1 } }; // with '\0' terminator
+    server->WriteV(buffers, 3);
+
+    const std::string expected("metizik:Hello!\0", 15);
+    std::string received;
+    std::string portion;
+    while (received.size() < expected.size())
+    {
+        client.Read(portion);
+        ASSERT_FALSE(portion.empty());
+        received += portion;
+    }
+
+    EXPECT_EQ(expected, received);
+}
+
+TEST(UringSocketWrapperTest, AcceptsSeveralConnections)
+{
+    if (!IoUring::IsSupported())
+    {
+        GTEST_SKIP() << "io_uring is not allowed by the kernel";
+    }
+    UringSocketWrapper listener;
+    listener.Bind(s_address, s_port);
+    listener.Listen();
+
+    std::vector<std::unique_ptr<UringSocketWrapper>> clients;
+    std::vector<ISocketWrapperPtr> accepted;
+    for (int i = 0; i < 3; ++i)
+    {
+        clients.emplace_back(new UringSocketWrapper);
+        clients.back()->Connect(s_address, s_port);
+        accepted.push_back(listener.Accept());
+    }
+
+    for (size_t i = 0; i < clients.size(); ++i)
+    {
+        accepted[i]->Write(std::to_string(i));
+        std::string received;
+        clients[i]->Read(received);
+        EXPECT_EQ(std::to_string(i), received);
+    }
+}
+
+TEST(UringSocketWrapperTest, ReadReturnsZeroWhenPeerCloses)
+{
+    if (!IoUring::IsSupported())
+    {
+        GTEST_SKIP() << "io_uring is not allowed by the kernel";
+    }
+    UringSocketWrapper listener;
+    UringSocketWrapper client;
+    listener.Bind(s_address, s_port);
+    listener.Listen();
+    auto connected = client.Connect(s_address, s_port);
+    listener.Accept().reset();
+
+    char buffer[16];
+    EXPECT_EQ(0u, connected->Read(buffer, sizeof(buffer)));
+}
+
+TEST(UringSocketWrapperTest, ThrowsWhenUsedByAnotherThread)
+{
+    if (!IoUring::IsSupported())
+    {
+        GTEST_SKIP() << "io_uring is not allowed by the kernel";
+    }
+    UringSocketWrapper listener;
+    listener.Bind(s_address, s_port);
+    listener.Listen();
+
+    bool thrown = false;
+    std::thread([&listener, &thrown]()
+    {
+        try
+        {
+            listener.Accept();
+        }
+        catch (const std::logic_error&)
+        {
+            thrown = true;
+        }
+    }).join();
+
+    EXPECT_TRUE(thrown);
+}
+
+TEST(UringSocketWrapperTest, FactoryCreatesWorkingSocket)
+{
+    auto listener = CreateSocketWrapper();
+    auto client = CreateSocketWrapper();
+
+    listener->Bind(s_address, s_port);
+    listener->Listen();
+    client->Connect(s_address, s_port);
+    auto server = listener->Accept();
+
+    server->Write("ping");
+    std::string received;
+    client->Read(received);
+
+    EXPECT_EQ("ping", received);
+}
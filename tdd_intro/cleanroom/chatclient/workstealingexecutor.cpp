@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "workstealingexecutor.h"
+
+namespace
+{
+    // Worker running on the current thread, to post free tasks into its own deque
+    thread_local const WorkStealingExecutor* s_currentExecutor = nullptr;
+    thread_local size_t s_currentWorker = 0;
+}
+
+WorkStealingExecutor::WorkStealingExecutor(size_t workers)
+    : m_nextWorker(0)
+    , m_pending(0)
+    , m_sleeping(0)
+    , m_stopping(false)
+{
+    // All the deques must exist before any worker tries to steal from them
+    for (size_t i = 0; i < std::max<size_t>(workers, 1); ++i)
+    {
+        m_workers.emplace_back(new Worker);
+    }
+    for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+        m_workers[i]->thread = std::thread(&WorkStealingExecutor::Run, this, i);
+    }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor()
+{
+    Wait();
+    m_stopping = true;
+    for (auto& worker : m_workers)
+    {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        worker->wakeUp.notify_all();
+    }
+    for (auto& worker : m_workers)
+    {
+        worker->thread.join();
+    }
+}
+
+size_t WorkStealingExecutor::GetWorkerCount() const
+{
+    return m_workers.size();
+}
+
+void WorkStealingExecutor::Post(Task task)
+{
+    if (s_currentExecutor == this)
+    {
+        Push(s_currentWorker, std::move(task), false);
+        // The owner is busy with the current task, so let an idle worker take the new one
+        PokeSleeping(s_currentWorker);
+        return;
+    }
+    const size_t index = m_nextWorker++ % m_workers.size();
+    Push(index, std::move(task), false);
+    // Push wakes up the worker only if it sleeps, a busy one leaves the task to be stolen
+    if (!m_workers[index]->sleeping)
+    {
+        PokeSleeping(index);
+    }
+}
+
+void WorkStealingExecutor::Post(size_t worker, Task task)
+{
+    if (worker >= m_workers.size())
+    {
+        throw std::out_of_range("Worker index is out of range.");
+    }
+    Push(worker, std::move(task), true);
+}
+
+void WorkStealingExecutor::Wait()
+{
+    std::unique_lock<std::mutex> lock(m_idleMutex);
+    m_idle.wait(lock, [this]() { return m_pending == 0; });
+}
+
+void WorkStealingExecutor::Run(size_t index)
+{
+    s_currentExecutor = this;
+    s_currentWorker = index;
+    Worker& self = *m_workers[index];
+
+    for (;;)
+    {
+        Task task;
+        if (!TakeOwn(index, task) && !Steal(index, task))
+        {
+            // Worker posting a free task pokes the sleeping ones, so announce the sleep before the last attempt
+            ++m_sleeping;
+            self.sleeping = true;
+            const bool stolen = Steal(index, task);
+            if (!stolen)
+            {
+                std::unique_lock<std::mutex> lock(self.mutex);
+                if (m_stopping)
+                {
+                    self.sleeping = false;
+                    --m_sleeping;
+                    return;
+                }
+                self.wakeUp.wait(lock, [this, &self]()
+                {
+                    return m_stopping || self.poked || !self.pinned.empty() || !self.free.empty();
+                });
+                self.poked = false;
+            }
+            self.sleeping = false;
+            --m_sleeping;
+            if (!stolen)
+            {
+                continue;
+            }
+        }
+
+        task();
+        if (m_pending.fetch_sub(1) == 1)
+        {
+            std::lock_guard<std::mutex> lock(m_idleMutex);
+            m_idle.notify_all();
+        }
+    }
+}
+
+bool WorkStealingExecutor::TakeOwn(size_t index, Task& task)
+{
+    Worker& worker = *m_workers[index];
+    bool more = false;
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (!worker.pinned.empty())
+        {
+            task = std::move(worker.pinned.front());
+            worker.pinned.pop_front();
+        }
+        else if (!worker.free.empty())
+        {
+            task = std::move(worker.free.back());
+            worker.free.pop_back();
+        }
+        else
+        {
+            return false;
+        }
+        more = !worker.free.empty();
+    }
+
+    // Free tasks left behind can be executed by an idle worker meanwhile
+    if (more)
+    {
+        PokeSleeping(index);
+    }
+    return true;
+}
+
+bool WorkStealingExecutor::Steal(size_t thief, Task& task)
+{
+    for (size_t i = 1; i < m_workers.size(); ++i)
+    {
+        Worker& victim = *m_workers[(thief + i) % m_workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.free.empty())
+        {
+            task = std::move(victim.free.front());
+            victim.free.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingExecutor::Push(size_t index, Task task, bool pinned)
+{
+    ++m_pending;
+    Worker& worker = *m_workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    (pinned ? worker.pinned : worker.free).push_back(std::move(task));
+    worker.wakeUp.notify_one();
+}
+
+void WorkStealingExecutor::PokeSleeping(size_t from)
+{
+    if (m_sleeping == 0)
+    {
+        return;
+    }
+
+    for (size_t i = 1; i < m_workers.size(); ++i)
+    {
+        Worker& worker = *m_workers[(from + i) % m_workers.size()];
+        if (worker.sleeping)
+        {
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.poked = true;
+            worker.wakeUp.notify_one();
+            return;
+        }
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Thread pool with a separate task deque per worker, usually one worker per core.
+ *
+ * Tasks can be posted in two ways:
+ *   * pinned to a worker - such tasks are executed only by that worker in the order of posting,
+ *     so all the writes to one connection stay ordered and never run concurrently;
+ *   * free - the task goes to the deque of the posting worker (or the next one in turn),
+ *     the owner takes the newest task from it, while idle workers steal the oldest ones.
+ * Workers lock only their own deque or the one they steal from, there is no lock shared by all of them.
+ *
+ * Tasks must not throw. Destructor executes all the posted tasks before joining the workers.
+*/
+
+class WorkStealingExecutor
+{
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingExecutor(size_t workers = std::thread::hardware_concurrency());
+    ~WorkStealingExecutor();
+    WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+    size_t GetWorkerCount() const;
+    // Posts the task, which may be executed by any worker.
+    void Post(Task task);
+    // Posts the task, which is executed only by the given worker after its previously pinned tasks.
+    void Post(size_t worker, Task task);
+    // Blocks until all the posted tasks are executed, including the ones posted meanwhile.
+    void Wait();
+
+private:
+    struct Worker
+    {
+        std::mutex mutex;
+        std::condition_variable wakeUp;
+        std::deque<Task> pinned;
+        std::deque<Task> free;
+        bool poked = false; // Woken up to steal from the others
+        std::atomic<bool> sleeping{false};
+        std::thread thread;
+    };
+
+    void Run(size_t index);
+    bool TakeOwn(size_t index, Task& task);
+    bool Steal(size_t thief, Task& task);
+    void Push(size_t index, Task task, bool pinned);
+    // Wakes up one of the sleeping workers other than the given one to steal a free task.
+    void PokeSleeping(size_t from);
+
+private:
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<size_t> m_nextWorker;
+    std::atomic<size_t> m_pending;
+    std::atomic<size_t> m_sleeping;
+    std::atomic<bool> m_stopping;
+    std::mutex m_idleMutex;
+    std::condition_variable m_idle;
+};
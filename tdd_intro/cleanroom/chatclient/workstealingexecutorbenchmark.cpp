@@ -0,0 +1,101 @@
+// Scaling of ChatServer broadcast over WorkStealingExecutor with different number of workers.
+// Every write to a peer is a real system call to /dev/null, so it costs about the same as a small send.
+// It is disabled by default, run it with --gtest_also_run_disabled_tests.
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <chrono>
+#include <iostream>
+#include "chatserver.h"
+#include "mocks.h"
+
+namespace
+{
+    const size_t s_peers = 256;
+    const size_t s_messages = 2000;
+
+    class DevNullPeerFake : public SocketStreamFake
+    {
+    public:
+        explicit DevNullPeerFake(const std::string& stream)
+            : SocketStreamFake(stream), m_null(open("/dev/null", O_WRONLY))
+        { }
+
+        ~DevNullPeerFake() { close(m_null); }
+
+        void Write(const std::string& buffer) override
+        {
+            if (write(m_null, buffer.data(), buffer.size()) == -1)
+            {
+                throw std::runtime_error("Failed to send data.");
+            }
+        }
+
+        void WriteV(const ConstBuffer* buffers, size_t count) override
+        {
+            std::string gathered;
+            for (size_t i = 0; i < count; ++i)
+            {
+                gathered.append(buffers[i].data, buffers[i].size);
+            }
+            Write(gathered);
+        }
+
+        size_t TryWriteV(const ConstBuffer* buffers, size_t count) override
+        {
+            WriteV(buffers, count);
+            size_t written = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                written += buffers[i].size;
+            }
+            return written;
+        }
+
+    private:
+        int m_null;
+    };
+
+    // Returns broadcast writes per second
+    double MeasureBroadcast(WorkStealingExecutor* executor)
+    {
+        std::string senderStream("sender:HELLO!\0", 14);
+        for (size_t i = 0; i < s_messages; ++i)
+        {
+            senderStream += "message number " + std::to_string(i);
+            senderStream += '\0';
+        }
+
+        ChatServer server("server", executor);
+        std::vector<std::shared_ptr<DevNullPeerFake>> receivers;
+        for (size_t i = 0; i < s_peers; ++i)
+        {
+            receivers.push_back(std::make_shared<DevNullPeerFake>("peer" + std::to_string(i) + std::string(":HELLO!\0", 8)));
+            server.AddPeer(receivers.back());
+            server.OnReadable(*receivers.back());
+        }
+        auto sender = std::make_shared<DevNullPeerFake>(senderStream);
+        server.AddPeer(sender);
+
+        auto start = std::chrono::steady_clock::now();
+        while (server.OnReadable(*sender))
+        {
+        }
+        if (executor)
+        {
+            executor->Wait();
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return s_messages * s_peers / seconds;
+    }
+}
+
+TEST(WorkStealingExecutorBenchmark, DISABLED_BroadcastScaling)
+{
+    std::cout << "Inline writes: " << MeasureBroadcast(nullptr) << " writes/s" << std::endl;
+    for (size_t workers : { 1, 2, 4, 8 })
+    {
+        WorkStealingExecutor executor(workers);
+        std::cout << workers << " worker(s): " << MeasureBroadcast(&executor) << " writes/s" << std::endl;
+    }
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include "workstealingexecutor.h"
+
+TEST(WorkStealingExecutorTest, ExecutesAllPostedTasks)
+{
+    WorkStealingExecutor executor(4);
+    std::atomic<size_t> executed(0);
+
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        executor.Post([&executed]() { ++executed; });
+    }
+    executor.Wait();
+
+    EXPECT_EQ(1000u, executed);
+}
+
+TEST(WorkStealingExecutorTest, WaitsForTasksPostedByTasks)
+{
+    WorkStealingExecutor executor(2);
+    std::atomic<size_t> executed(0);
+
+    executor.Post([&executor, &executed]()
+    {
+        for (size_t i = 0; i < 100; ++i)
+        {
+            executor.Post([&executed]() { ++executed; });
+        }
+    });
+    executor.Wait();
+
+    EXPECT_EQ(100u, executed);
+}
+
+TEST(WorkStealingExecutorTest, ExecutesPinnedTasksInOrderOnTheirWorker)
+{
+    WorkStealingExecutor executor(4);
+    std::vector<size_t> order;
+    std::vector<std::thread::id> threads;
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+        executor.Post(2, [i, &order, &threads]()
+        {
+            order.push_back(i);
+            threads.push_back(std::this_thread::get_id());
+        });
+    }
+    executor.Wait();
+
+    ASSERT_EQ(100u, order.size());
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        EXPECT_EQ(i, order[i]);
+        EXPECT_EQ(threads.front(), threads[i]);
+    }
+}
+
+TEST(WorkStealingExecutorTest, IdleWorkerStealsTaskOfBusyOne)
+{
+    WorkStealingExecutor executor(2);
+    std::promise<void> stolen;
+    bool completed = false;
+
+    // Free task goes into the deque of the posting worker, which is blocked until the task is done
+    executor.Post(0, [&executor, &stolen, &completed]()
+    {
+        executor.Post([&stolen]() { stolen.set_value(); });
+        completed = stolen.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+    });
+    executor.Wait();
+
+    EXPECT_TRUE(completed);
+}
+
+TEST(WorkStealingExecutorTest, IdleWorkerStealsTaskPostedFromOutsideToBusyOne)
+{
+    WorkStealingExecutor executor(2);
+    std::promise<void> started;
+    std::promise<void> stolen;
+    bool completed = false;
+
+    executor.Post(0, [&started, &stolen, &completed]()
+    {
+        started.set_value();
+        completed = stolen.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+    });
+    started.get_future().wait();
+    // Lets the other worker fall asleep, so only the poke wakes it up
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    // The first free task goes to the busy worker 0 in turn
+    executor.Post([&stolen]() { stolen.set_value(); });
+    executor.Wait();
+
+    EXPECT_TRUE(completed);
+}
+
+TEST(WorkStealingExecutorTest, ThrowsWhenPinnedToUnknownWorker)
+{
+    WorkStealingExecutor executor(2);
+
+    EXPECT_THROW(executor.Post(2, []() {}), std::out_of_range);
+}
+
+TEST(WorkStealingExecutorTest, CreatesAtLeastOneWorker)
+{
+    WorkStealingExecutor executor(0);
+
+    EXPECT_EQ(1u, executor.GetWorkerCount());
+}
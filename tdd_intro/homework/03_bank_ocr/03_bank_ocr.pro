@@ -1,9 +1,51 @@
 include(../../gtest.pri)
 
 TEMPLATE = app
-CONFIG += console c++11
+CONFIG += console c++2a
 CONFIG -= app_bundle
 CONFIG -= qt
 
 SOURCES += \
-    test.cpp
+    test.cpp \
+    ocrdecoder.cpp \
+    ocrdecoderbenchmark.cpp \
+    ocrparsertest.cpp \
+    ocrparserbenchmark.cpp \
+    ocrpipeline.cpp \
+    ocrpipelinetest.cpp \
+    ocrpipelinebenchmark.cpp \
+    ocrvalidator.cpp \
+    ocrvalidatortest.cpp \
+    ocrvalidatorbenchmark.cpp \
+    ocrfuzzydecoder.cpp \
+    ocrfuzzydecodertest.cpp \
+    ocrfuzzydecoderbenchmark.cpp \
+    accountwriter.cpp \
+    accountwritertest.cpp \
+    accountwriterbenchmark.cpp \
+    ocrcorpus.cpp \
+    ocrcorpustest.cpp \
+    ocrcorpusbenchmark.cpp \
+    orderedchunkstest.cpp
+
+HEADERS += \
+    ocrglyphs.h \
+    ocrdecoder.h \
+    ocrparser.h \
+    ocrpipeline.h \
+    ocrvalidator.h \
+    ocrfuzzydecoder.h \
+    accountwriter.h \
+    ocrcorpus.h \
+    orderedchunks.h \
+    mappedfile.h
+
+win32 {
+    SOURCES += \
+        mappedfile_win.cpp
+}
+
+unix {
+    SOURCES += \
+        mappedfile_posix.cpp
+}
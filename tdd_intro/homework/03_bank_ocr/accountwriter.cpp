@@ -0,0 +1,124 @@
+#include <cstring>
+#include <stdexcept>
+
+#include "accountwriter.h"
+
+namespace
+{
+    const std::string_view s_textPrefix = "=> ";
+    const std::string_view s_illegibleSuffix = " ILL";
+
+    size_t GetBitmapSize(size_t count)
+    {
+        return (count + 7) / 8;
+    }
+}
+
+AccountWriter::AccountWriter(std::ostream& stream, Format format)
+    : m_stream(stream)
+    , m_format(format)
+    , m_count(0)
+    , m_records(s_recordsPerBlock * g_accountDigits)
+    , m_legible(GetBitmapSize(s_recordsPerBlock))
+{
+}
+
+void AccountWriter::Write(const AccountNumber& number)
+{
+    std::memcpy(m_records.data() + m_count * g_accountDigits, number.digits, g_accountDigits);
+    uint8_t& bits = m_legible[m_count / 8];
+    const uint8_t bit = static_cast<uint8_t>(1 << (m_count % 8));
+    bits = static_cast<uint8_t>(number.legible ? bits | bit : bits & ~bit);
+    if (++m_count == s_recordsPerBlock)
+    {
+        Flush();
+    }
+}
+
+void AccountWriter::Flush()
+{
+    if (m_count == 0)
+    {
+        return;
+    }
+    if (m_format == Format::Packed)
+    {
+        WritePacked();
+    }
+    else
+    {
+        WriteText();
+    }
+    m_count = 0;
+
+    m_stream.write(m_block.data(), m_block.size());
+    m_stream.flush();
+    if (!m_stream)
+    {
+        throw std::runtime_error("Failed to write the account numbers.");
+    }
+}
+
+void AccountWriter::WritePacked()
+{
+    const uint32_t count = static_cast<uint32_t>(m_count);
+    const size_t recordsSize = m_count * g_accountDigits;
+    m_block.resize(sizeof(count) + recordsSize + GetBitmapSize(m_count));
+    char* position = m_block.data();
+    std::memcpy(position, &count, sizeof(count));
+    std::memcpy(position + sizeof(count), m_records.data(), recordsSize);
+    std::memcpy(position + sizeof(count) + recordsSize, m_legible.data(), GetBitmapSize(m_count));
+}
+
+void AccountWriter::WriteText()
+{
+    const size_t lineSize = s_textPrefix.size() + g_accountDigits + s_illegibleSuffix.size() + 1;
+    m_block.resize(m_count * lineSize);
+    char* position = m_block.data();
+    for (size_t i = 0; i < m_count; ++i)
+    {
+        std::memcpy(position, s_textPrefix.data(), s_textPrefix.size());
+        position += s_textPrefix.size();
+        std::memcpy(position, m_records.data() + i * g_accountDigits, g_accountDigits);
+        position += g_accountDigits;
+        if (!(m_legible[i / 8] & (1 << (i % 8))))
+        {
+            std::memcpy(position, s_illegibleSuffix.data(), s_illegibleSuffix.size());
+            position += s_illegibleSuffix.size();
+        }
+        *position++ = '\n';
+    }
+    m_block.resize(position - m_block.data());
+}
+
+size_t ReadPackedAccounts(std::string_view data, std::vector<AccountNumber>& numbers)
+{
+    size_t read = 0;
+    while (!data.empty())
+    {
+        uint32_t count;
+        if (data.size() < sizeof(count))
+        {
+            throw std::runtime_error("Incomplete block of the account numbers.");
+        }
+        std::memcpy(&count, data.data(), sizeof(count));
+        const size_t recordsSize = count * g_accountDigits;
+        if (data.size() < sizeof(count) + recordsSize + GetBitmapSize(count))
+        {
+            throw std::runtime_error("Incomplete block of the account numbers.");
+        }
+
+        const char* records = data.data() + sizeof(count);
+        const uint8_t* legible = reinterpret_cast<const uint8_t*>(records + recordsSize);
+        for (size_t i = 0; i < count; ++i)
+        {
+            AccountNumber number = {};
+            std::memcpy(number.digits, records + i * g_accountDigits, g_accountDigits);
+            number.legible = (legible[i / 8] >> (i % 8)) & 1;
+            numbers.push_back(number);
+        }
+        read += count;
+        data.remove_prefix(sizeof(count) + recordsSize + GetBitmapSize(count));
+    }
+    return read;
+}
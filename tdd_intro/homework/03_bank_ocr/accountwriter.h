@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+#include "ocrparser.h"
+
+/*
+ * Output stage of the decoded account numbers.
+ *
+ * Numbers are collected in columns: packed records of g_accountDigits characters and a bitmap of the legible
+ * ones, and go to the stream in blocks of up to s_recordsPerBlock numbers with a single write each.
+ * Packed block is the count of the records (32-bit, native byte order), the records and the bitmap.
+ * Blocks are self-contained, so the output of several runs may be appended to one file.
+ * Text format renders the same columns into "=> 123456789" lines, with " ILL" after the illegible ones.
+ *
+ * Write and Flush throw std::runtime_error if the stream fails. Numbers, which are not flushed, are lost.
+*/
+
+class AccountWriter
+{
+public:
+    enum class Format
+    {
+        Packed,
+        Text
+    };
+
+    static const size_t s_recordsPerBlock = 64 * 1024;
+
+    explicit AccountWriter(std::ostream& stream, Format format = Format::Packed);
+
+    void Write(const AccountNumber& number);
+    // Writes the collected numbers as one block
+    void Flush();
+
+private:
+    void WritePacked();
+    void WriteText();
+
+private:
+    std::ostream& m_stream;
+    const Format m_format;
+    size_t m_count;
+    std::vector<char> m_records;
+    std::vector<uint8_t> m_legible;
+    std::vector<char> m_block;
+};
+
+// Reads the numbers of the packed blocks, returns their number. Masks of the numbers are not stored and stay zero.
+// Throws std::runtime_error if the last block is incomplete.
+size_t ReadPackedAccounts(std::string_view data, std::vector<AccountNumber>& numbers);
@@ -0,0 +1,90 @@
+// File to file throughput: the mapped scan of 512 MB is parsed and the numbers are written with iostreams
+// line by line, and with AccountWriter as text and as packed blocks.
+// It is disabled by default, run it with --gtest_also_run_disabled_tests.
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "accountwriter.h"
+#include "mappedfile.h"
+#include "ocrcorpus.h"
+#include "ocrpipeline.h"
+
+namespace
+{
+    const size_t s_fixtureSize = size_t(1) << 29;
+
+    // Writes random entries into the file, a 16th of them with a segment dropped or added
+    void GenerateFixture(const std::string& path)
+    {
+        CorpusOptions options;
+        options.entries = s_fixtureSize / g_renderedEntrySize;
+        options.noise = 1.0 / 16;
+        std::ofstream file(path, std::ios::binary);
+        WriteCorpus(file, options);
+    }
+
+    // Returns megabytes of the scan per second
+    template <typename Converter>
+    double Measure(const std::string& input, const std::string& output, Converter convert)
+    {
+        auto start = std::chrono::steady_clock::now();
+        {
+            MappedFile file(input);
+            std::ofstream stream(output, std::ios::binary);
+            convert(file.GetData(), stream);
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return std::filesystem::file_size(input) / seconds / (1 << 20);
+    }
+}
+
+TEST(AccountWriterBenchmark, DISABLED_FileToFile)
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    const std::string input = (directory / "accountwriterbenchmark.txt").string();
+    const std::string output = (directory / "accountwriterbenchmark.out").string();
+    GenerateFixture(input);
+
+    const double lines = Measure(input, output, [](std::string_view data, std::ofstream& stream)
+    {
+        ParseEntries(data, [&stream](const AccountNumber& number)
+        {
+            stream << "=> " << std::string(number.digits, g_accountDigits) << (number.legible ? "" : " ILL") << '\n';
+        });
+    });
+    const uintmax_t linesSize = std::filesystem::file_size(output);
+
+    const double text = Measure(input, output, [](std::string_view data, std::ofstream& stream)
+    {
+        AccountWriter writer(stream, AccountWriter::Format::Text);
+        ParseEntries(data, [&writer](const AccountNumber& number) { writer.Write(number); });
+        writer.Flush();
+    });
+    EXPECT_EQ(linesSize, std::filesystem::file_size(output));
+
+    const double packed = Measure(input, output, [](std::string_view data, std::ofstream& stream)
+    {
+        AccountWriter writer(stream);
+        ParseEntries(data, [&writer](const AccountNumber& number) { writer.Write(number); });
+        writer.Flush();
+    });
+    const uintmax_t packedSize = std::filesystem::file_size(output);
+
+    const double parallel = Measure(input, output, [](std::string_view data, std::ofstream& stream)
+    {
+        AccountWriter writer(stream);
+        ParseEntriesParallel(data, 0, [&writer](const AccountNumber& number) { writer.Write(number); });
+        writer.Flush();
+    });
+
+    std::cout << "Lines with iostreams: " << lines << " MB/s, " << linesSize / (1 << 20) << " MB written" << std::endl;
+    std::cout << "Text blocks: " << text << " MB/s" << std::endl;
+    std::cout << "Packed blocks: " << packed << " MB/s, " << packedSize / (1 << 20) << " MB written" << std::endl;
+    std::cout << "Packed blocks, parallel parser: " << parallel << " MB/s" << std::endl;
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "accountwriter.h"
+
+namespace
+{
+    AccountNumber MakeNumber(const std::string& digits)
+    {
+        AccountNumber number = {};
+        digits.copy(number.digits, g_accountDigits);
+        number.legible = digits.find(g_illegibleDigit) == std::string::npos;
+        return number;
+    }
+
+    std::string ToString(const AccountNumber& number)
+    {
+        return std::string(number.digits, g_accountDigits) + (number.legible ? "" : " ILL");
+    }
+
+    std::vector<std::string> ReadAll(const std::string& data)
+    {
+        std::vector<AccountNumber> numbers;
+        ReadPackedAccounts(data, numbers);
+        std::vector<std::string> result;
+        for (const AccountNumber& number : numbers)
+        {
+            result.push_back(ToString(number));
+        }
+        return result;
+    }
+}
+
+TEST(AccountWriterTest, WritesNothingBeforeFlush)
+{
+    std::ostringstream stream;
+    AccountWriter writer(stream);
+    writer.Write(MakeNumber("123456789"));
+    EXPECT_EQ("", stream.str());
+}
+
+TEST(AccountWriterTest, WritesPackedBlock)
+{
+    std::ostringstream stream;
+    AccountWriter writer(stream);
+    writer.Write(MakeNumber("123456789"));
+    writer.Write(MakeNumber("86110??36"));
+    writer.Flush();
+
+    const std::string data = stream.str();
+    ASSERT_EQ(4 + 2 * g_accountDigits + 1, data.size());
+    EXPECT_EQ("12345678986110??36", data.substr(4, 2 * g_accountDigits));
+    EXPECT_EQ(1, data.back());
+    EXPECT_EQ(std::vector<std::string>({ "123456789", "86110??36 ILL" }), ReadAll(data));
+}
+
+TEST(AccountWriterTest, SplitsNumbersIntoBlocks)
+{
+    std::ostringstream stream;
+    AccountWriter writer(stream);
+    const size_t count = AccountWriter::s_recordsPerBlock + 10;
+    for (size_t i = 0; i < count; ++i)
+    {
+        writer.Write(MakeNumber(i % 3 ? "000000000" : "1?1111111"));
+    }
+    writer.Flush();
+
+    const std::vector<std::string> numbers = ReadAll(stream.str());
+    ASSERT_EQ(count, numbers.size());
+    EXPECT_EQ("1?1111111 ILL", numbers[AccountWriter::s_recordsPerBlock - 1]);
+    EXPECT_EQ("000000000", numbers[AccountWriter::s_recordsPerBlock + 1]);
+}
+
+TEST(AccountWriterTest, BlocksMayBeAppended)
+{
+    std::ostringstream stream;
+    {
+        AccountWriter writer(stream);
+        writer.Write(MakeNumber("111111111"));
+        writer.Flush();
+    }
+    AccountWriter writer(stream);
+    writer.Write(MakeNumber("222222222"));
+    writer.Flush();
+    EXPECT_EQ(std::vector<std::string>({ "111111111", "222222222" }), ReadAll(stream.str()));
+}
+
+TEST(AccountWriterTest, RendersText)
+{
+    std::ostringstream stream;
+    AccountWriter writer(stream, AccountWriter::Format::Text);
+    writer.Write(MakeNumber("123456789"));
+    writer.Write(MakeNumber("86110??36"));
+    writer.Flush();
+    EXPECT_EQ("=> 123456789\n=> 86110??36 ILL\n", stream.str());
+}
+
+TEST(AccountWriterTest, ThrowsOnIncompleteBlock)
+{
+    std::ostringstream stream;
+    AccountWriter writer(stream);
+    writer.Write(MakeNumber("123456789"));
+    writer.Flush();
+
+    std::vector<AccountNumber> numbers;
+    EXPECT_THROW(ReadPackedAccounts(stream.str().substr(0, 10), numbers), std::runtime_error);
+    EXPECT_THROW(ReadPackedAccounts("ab", numbers), std::runtime_error);
+}
+
+TEST(AccountWriterTest, ThrowsIfStreamFails)
+{
+    std::ostringstream stream;
+    stream.setstate(std::ios::badbit);
+    AccountWriter writer(stream);
+    writer.Write(MakeNumber("123456789"));
+    EXPECT_THROW(writer.Flush(), std::runtime_error);
+}
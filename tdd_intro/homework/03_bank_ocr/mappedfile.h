@@ -0,0 +1,24 @@
+#pragma once
+#include <string>
+#include <string_view>
+
+/*
+ * Read-only memory mapping of the whole file, for the parsers to walk it without reading into buffers.
+ *
+ * Constructor throws std::runtime_error if the file can't be opened or mapped.
+*/
+
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::string_view GetData() const;
+
+private:
+    const char* m_data;
+    size_t m_size;
+};
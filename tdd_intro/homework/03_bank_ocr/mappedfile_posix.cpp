@@ -0,0 +1,65 @@
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include "mappedfile.h"
+
+namespace
+{
+    std::string GetExceptionString(const std::string& message, int errorCode)
+    {
+        return message + " " + std::to_string(errorCode) + " " + std::strerror(errorCode) + "\n";
+    }
+}
+
+MappedFile::MappedFile(const std::string& path)
+    : m_data(nullptr)
+    , m_size(0)
+{
+    const int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file == -1)
+    {
+        throw std::runtime_error(GetExceptionString("Failed to open file " + path + ".", errno));
+    }
+
+    struct stat status;
+    if (fstat(file, &status) == -1)
+    {
+        const int error = errno;
+        close(file);
+        throw std::runtime_error(GetExceptionString("Failed to get size of file " + path + ".", error));
+    }
+
+    m_size = static_cast<size_t>(status.st_size);
+    if (m_size > 0)
+    {
+        void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (data == MAP_FAILED)
+        {
+            const int error = errno;
+            close(file);
+            throw std::runtime_error(GetExceptionString("Failed to map file " + path + ".", error));
+        }
+        // Parsers walk the file once from the beginning to the end
+        madvise(data, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const char*>(data);
+    }
+    close(file); // Mapping stays valid without the descriptor
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data)
+    {
+        munmap(const_cast<char*>(m_data), m_size);
+    }
+}
+
+std::string_view MappedFile::GetData() const
+{
+    return std::string_view(m_data, m_size);
+}
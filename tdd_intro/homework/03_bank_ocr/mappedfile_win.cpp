@@ -0,0 +1,63 @@
+#include <Windows.h>
+#include <stdexcept>
+
+#include "mappedfile.h"
+
+namespace
+{
+    std::string GetExceptionString(const std::string& message, DWORD errorCode)
+    {
+        return message + " " + std::to_string(errorCode) + "\n";
+    }
+}
+
+MappedFile::MappedFile(const std::string& path)
+    : m_data(nullptr)
+    , m_size(0)
+{
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error(GetExceptionString("Failed to open file " + path + ".", GetLastError()));
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size))
+    {
+        const DWORD error = GetLastError();
+        CloseHandle(file);
+        throw std::runtime_error(GetExceptionString("Failed to get size of file " + path + ".", error));
+    }
+
+    m_size = static_cast<size_t>(size.QuadPart);
+    if (m_size > 0)
+    {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        const void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        const DWORD error = GetLastError();
+        if (mapping)
+        {
+            CloseHandle(mapping); // View keeps the mapping alive
+        }
+        if (!data)
+        {
+            CloseHandle(file);
+            throw std::runtime_error(GetExceptionString("Failed to map file " + path + ".", error));
+        }
+        m_data = static_cast<const char*>(data);
+    }
+    CloseHandle(file);
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data)
+    {
+        UnmapViewOfFile(m_data);
+    }
+}
+
+std::string_view MappedFile::GetData() const
+{
+    return std::string_view(m_data, m_size);
+}
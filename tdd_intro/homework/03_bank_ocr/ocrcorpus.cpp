@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "ocrcorpus.h"
+#include "orderedchunks.h"
+
+namespace
+{
+    const size_t s_entriesPerChunk = 16 * 1024;
+    const size_t s_slotsPerThread = 2;
+    const size_t s_lineSize = g_entryWidth + 1;
+
+    struct Segment
+    {
+        size_t row;
+        size_t column;
+        char character;
+    };
+
+    // Places of a cell, where the glyphs have their segments
+    const Segment s_segments[] = {
+        { 0, 1, '_' },
+        { 1, 0, '|' }, { 1, 1, '_' }, { 1, 2, '|' },
+        { 2, 0, '|' }, { 2, 1, '_' }, { 2, 2, '|' }
+    };
+    const size_t s_segmentCount = sizeof(s_segments) / sizeof(s_segments[0]);
+
+    // SplitMix64 hash, well mixed for the consecutive entry numbers
+    uint64_t Mix(uint64_t value)
+    {
+        value += 0x9e3779b97f4a7c15ull;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+        return value ^ (value >> 31);
+    }
+
+    void RenderCorpusEntry(const CorpusOptions& options, size_t entry, char* text)
+    {
+        char digits[g_accountDigits];
+        GetCorpusDigits(options, entry, digits);
+        RenderEntryLines(digits, text);
+
+        const uint64_t noise = Mix(Mix(options.seed) ^ ~static_cast<uint64_t>(entry));
+        if (static_cast<double>(noise >> 11) * 0x1.0p-53 < options.noise)
+        {
+            const size_t place = static_cast<size_t>(noise % (g_accountDigits * s_segmentCount));
+            const Segment& segment = s_segments[place % s_segmentCount];
+            char& character = text[segment.row * s_lineSize + place / s_segmentCount * g_glyphSize + segment.column];
+            character = character == ' ' ? segment.character : ' ';
+        }
+    }
+}
+
+void RenderEntryLines(const char* digits, char* text)
+{
+    for (size_t row = 0; row < g_glyphSize; ++row)
+    {
+        char* line = text + row * s_lineSize;
+        for (size_t i = 0; i < g_accountDigits; ++i)
+        {
+            std::memcpy(line + i * g_glyphSize, g_glyphs[digits[i] - '0'][row].data(), g_glyphSize);
+        }
+        line[g_entryWidth] = '\n';
+    }
+    text[g_renderedEntrySize - 1] = '\n';
+}
+
+void GetCorpusDigits(const CorpusOptions& options, size_t entry, char* digits)
+{
+    uint64_t value = Mix(Mix(options.seed) ^ static_cast<uint64_t>(entry));
+    for (size_t i = 0; i < g_accountDigits; ++i)
+    {
+        digits[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+void WriteCorpus(std::ostream& stream, const CorpusOptions& options)
+{
+    const size_t threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    const size_t chunkCount = (options.entries + s_entriesPerChunk - 1) / s_entriesPerChunk;
+    size_t nextChunk = 0; // Taken under the lock of the workers
+    OrderedChunkWorkers<size_t, std::vector<char>> renderer(threads, s_slotsPerThread,
+        [&nextChunk, chunkCount](size_t& chunk)
+        {
+            if (nextChunk == chunkCount)
+            {
+                return false;
+            }
+            chunk = nextChunk++;
+            return true;
+        },
+        [&options](size_t chunk, std::vector<char>& text)
+        {
+            const size_t first = chunk * s_entriesPerChunk;
+            const size_t count = std::min(s_entriesPerChunk, options.entries - first);
+            text.resize(count * g_renderedEntrySize);
+            for (size_t i = 0; i < count; ++i)
+            {
+                RenderCorpusEntry(options, first + i, text.data() + i * g_renderedEntrySize);
+            }
+        });
+
+    std::vector<char> text;
+    while (renderer.Next(text))
+    {
+        stream.write(text.data(), text.size());
+        if (!stream)
+        {
+            throw std::runtime_error("Failed to write the corpus.");
+        }
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include "ocrglyphs.h"
+
+/*
+ * Generator of the synthetic scanner files for the benchmarks and the fuzz tests.
+ *
+ * Entry i of the corpus depends on the seed and i only: its digits, and optionally one segment dropped
+ * or added by the "scanner", are drawn from a hash of them. So the entries are rendered by several threads
+ * in chunks, any of them can be checked without the rest (GetCorpusDigits), and the file is the same
+ * for any number of threads. Chunks are written to the stream in order as soon as they are rendered,
+ * with a bounded number of them in memory.
+*/
+
+// Entry of 3 lines of glyphs and the blank one, with "\n" line breaks
+const size_t g_renderedEntrySize = 3 * (g_entryWidth + 1) + 1;
+
+struct CorpusOptions
+{
+    size_t entries = 0;
+    uint64_t seed = 42;
+    double noise = 0; // Share of the entries with one segment dropped or added
+    size_t threads = 0; // Zero means one per hardware thread
+};
+
+// Renders g_accountDigits digit characters into g_renderedEntrySize characters of the text.
+void RenderEntryLines(const char* digits, char* text);
+// Digits of the entry of the corpus, as they were before the noise.
+void GetCorpusDigits(const CorpusOptions& options, size_t entry, char* digits);
+// Writes the corpus to the stream. Throws std::runtime_error if the stream fails.
+void WriteCorpus(std::ostream& stream, const CorpusOptions& options);
@@ -0,0 +1,44 @@
+// Speed of writing the corpus of 1 GB with noise into a file, by one thread and by one per hardware thread.
+// It is disabled by default, run it with --gtest_also_run_disabled_tests.
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "ocrcorpus.h"
+
+namespace
+{
+    const size_t s_corpusSize = size_t(1) << 30;
+
+    // Returns megabytes per second
+    double Measure(const std::string& path, size_t threads)
+    {
+        CorpusOptions options;
+        options.entries = s_corpusSize / g_renderedEntrySize;
+        options.noise = 0.1;
+        options.threads = threads;
+
+        auto start = std::chrono::steady_clock::now();
+        {
+            std::ofstream file(path, std::ios::binary);
+            WriteCorpus(file, options);
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        EXPECT_EQ(options.entries * g_renderedEntrySize, std::filesystem::file_size(path));
+        return options.entries * g_renderedEntrySize / seconds / (1 << 20);
+    }
+}
+
+TEST(OcrCorpusBenchmark, DISABLED_WriteCorpusFile)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "ocrcorpusbenchmark.txt").string();
+    const size_t threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "1 thread: " << Measure(path, 1) << " MB/s" << std::endl;
+    std::cout << threads << " threads: " << Measure(path, threads) << " MB/s" << std::endl;
+    std::remove(path.c_str());
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <bit>
+#include <sstream>
+#include <string>
+#include "ocrcorpus.h"
+#include "ocrparser.h"
+
+namespace
+{
+    std::string Generate(const CorpusOptions& options)
+    {
+        std::ostringstream stream;
+        WriteCorpus(stream, options);
+        return stream.str();
+    }
+
+    // Segments, which differ from the glyphs of the digits the entry was rendered of
+    int CountNoise(const CorpusOptions& options, size_t entry, const AccountNumber& number)
+    {
+        char digits[g_accountDigits];
+        GetCorpusDigits(options, entry, digits);
+        int noise = 0;
+        for (size_t i = 0; i < g_accountDigits; ++i)
+        {
+            noise += std::popcount(static_cast<unsigned>(number.masks[i] ^ GetGlyphMask(digits[i] - '0')));
+        }
+        return noise;
+    }
+}
+
+TEST(OcrCorpusTest, RendersEntryLines)
+{
+    char text[g_renderedEntrySize];
+    RenderEntryLines("123456789", text);
+    const EntryText expected = RenderEntry("123456789");
+    EXPECT_EQ(std::string(expected.lines[0]) + "\n" + expected.lines[1] + "\n" + expected.lines[2] + "\n\n",
+              std::string(text, g_renderedEntrySize));
+}
+
+TEST(OcrCorpusTest, WritesEntriesOfCorpusDigits)
+{
+    CorpusOptions options;
+    options.entries = 40000;
+    const std::string corpus = Generate(options);
+    ASSERT_EQ(options.entries * g_renderedEntrySize, corpus.size());
+
+    size_t entry = 0;
+    ParseEntries(corpus, [&options, &entry](const AccountNumber& number)
+    {
+        char digits[g_accountDigits];
+        GetCorpusDigits(options, entry++, digits);
+        EXPECT_TRUE(number.legible);
+        EXPECT_EQ(std::string(digits, g_accountDigits), std::string(number.digits, g_accountDigits));
+    });
+    EXPECT_EQ(options.entries, entry);
+}
+
+TEST(OcrCorpusTest, CorpusDependsOnSeedOnly)
+{
+    CorpusOptions options;
+    options.entries = 50000;
+    options.noise = 0.5;
+    options.threads = 1;
+    const std::string single = Generate(options);
+    options.threads = 4;
+    EXPECT_EQ(single, Generate(options));
+    options.seed = 7;
+    EXPECT_NE(single, Generate(options));
+}
+
+TEST(OcrCorpusTest, AddsOneSegmentOfNoise)
+{
+    CorpusOptions options;
+    options.entries = 1000;
+    options.noise = 1;
+    size_t entry = 0;
+    ParseEntries(Generate(options), [&options, &entry](const AccountNumber& number)
+    {
+        EXPECT_EQ(1, CountNoise(options, entry++, number));
+    });
+    EXPECT_EQ(options.entries, entry);
+}
+
+TEST(OcrCorpusTest, AddsNoiseToShareOfEntries)
+{
+    CorpusOptions options;
+    options.entries = 10000;
+    options.noise = 0.25;
+    size_t entry = 0;
+    size_t noisy = 0;
+    ParseEntries(Generate(options), [&options, &entry, &noisy](const AccountNumber& number)
+    {
+        noisy += CountNoise(options, entry++, number);
+    });
+    EXPECT_NEAR(2500, noisy, 200);
+}
@@ -0,0 +1,69 @@
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OCR_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "ocrdecoder.h"
+
+namespace
+{
+    // Bits of the characters of the line, which are not spaces: bit i for column i
+    uint32_t GetLineBits(std::string_view line)
+    {
+        const size_t size = std::min(line.size(), g_entryWidth);
+#ifdef OCR_USE_SSE2
+        if (size >= 16)
+        {
+            // Two loads cover up to 32 columns, they overlap for the shorter lines and never read past the end
+            const __m128i spaces = _mm_set1_epi8(' ');
+            const __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(line.data()));
+            const __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(line.data() + size - 16));
+            const uint32_t headBits = ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(head, spaces))) & 0xffff;
+            const uint32_t tailBits = ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(tail, spaces))) & 0xffff;
+            return headBits | (tailBits << (size - 16));
+        }
+#endif
+        uint32_t bits = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            bits |= static_cast<uint32_t>(line[i] != ' ') << i;
+        }
+        return bits;
+    }
+
+    uint16_t PackCell(uint32_t top, uint32_t middle, uint32_t bottom, size_t column)
+    {
+        return static_cast<uint16_t>(((top >> column) & 7) | (((middle >> column) & 7) << 3) | (((bottom >> column) & 7) << 6));
+    }
+}
+
+void GetEntryMasks(std::string_view top, std::string_view middle, std::string_view bottom, uint16_t* masks)
+{
+    const uint32_t topBits = GetLineBits(top);
+    const uint32_t middleBits = GetLineBits(middle);
+    const uint32_t bottomBits = GetLineBits(bottom);
+    for (size_t i = 0; i < g_accountDigits; ++i)
+    {
+        masks[i] = PackCell(topBits, middleBits, bottomBits, i * 3);
+    }
+}
+
+bool DecodeMasks(const uint16_t* masks, char* digits)
+{
+    bool legible = true;
+    for (size_t i = 0; i < g_accountDigits; ++i)
+    {
+        digits[i] = DecodeMask(masks[i]);
+        legible &= digits[i] != g_illegibleDigit;
+    }
+    return legible;
+}
+
+bool DecodeEntry(std::string_view top, std::string_view middle, std::string_view bottom, char* digits)
+{
+    uint16_t masks[g_accountDigits];
+    GetEntryMasks(top, middle, bottom, masks);
+    return DecodeMasks(masks, digits);
+}
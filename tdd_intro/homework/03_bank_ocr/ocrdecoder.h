@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "ocrglyphs.h"
+
+/*
+ * Decoder of the bank OCR account numbers.
+ *
+ * The digit of a cell is taken from the 512-entry table by its mask (see GetCellMask),
+ * instead of comparing the cell with all the ten templates. The table is built at compile time.
+ *
+ * DecodeEntry packs all 9 cells of the entry at once: with SSE2 one compare of 16 characters
+ * gives the bits of 16 columns of a line, and every cell is just three 3-bit pieces of them.
+ * Lines may be shorter than 27 characters (trailing spaces are trimmed), missing characters are spaces.
+*/
+
+const char g_illegibleDigit = '?';
+
+namespace OcrDecoderDetail
+{
+    const size_t s_maskCount = 512;
+
+    struct DigitTable
+    {
+        char digits[s_maskCount];
+    };
+
+    constexpr DigitTable MakeDigitTable()
+    {
+        DigitTable table = {};
+        for (char& digit : table.digits)
+        {
+            digit = g_illegibleDigit;
+        }
+        for (int digit = 0; digit < 10; ++digit)
+        {
+            table.digits[GetGlyphMask(digit)] = static_cast<char>('0' + digit);
+        }
+        return table;
+    }
+
+    inline constexpr DigitTable s_digitTable = MakeDigitTable();
+
+    // Two glyphs of the same mask would overwrite one another in the table
+    constexpr bool IsCollisionFree()
+    {
+        for (int digit = 0; digit < 10; ++digit)
+        {
+            if (s_digitTable.digits[GetGlyphMask(digit)] != '0' + digit)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(IsCollisionFree(), "Every glyph must have its own mask.");
+    static_assert(s_digitTable.digits[0] == g_illegibleDigit, "Blank cell must not be a digit.");
+}
+
+// Digit character '0'..'9' of the cell mask, g_illegibleDigit if it is not a digit.
+constexpr char DecodeMask(uint16_t mask)
+{
+    return mask < OcrDecoderDetail::s_maskCount ? OcrDecoderDetail::s_digitTable.digits[mask] : g_illegibleDigit;
+}
+
+// Packs all g_accountDigits cells of the entry into masks.
+void GetEntryMasks(std::string_view top, std::string_view middle, std::string_view bottom, uint16_t* masks);
+// Decodes g_accountDigits masks into digit characters. Returns false if some of them are illegible.
+bool DecodeMasks(const uint16_t* masks, char* digits);
+// Decodes the three lines of the entry into g_accountDigits digit characters.
+// Returns false if some of them are illegible.
+bool DecodeEntry(std::string_view top, std::string_view middle, std::string_view bottom, char* digits);
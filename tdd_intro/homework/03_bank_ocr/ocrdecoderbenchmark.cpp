@@ -0,0 +1,107 @@
+// Entries per second of DecodeEntry compared with the naive decoder,
+// which compares every cell with the ten digit templates as strings.
+// It is disabled by default, run it with --gtest_also_run_disabled_tests.
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "ocrdecoder.h"
+
+namespace
+{
+    const size_t s_entries = 100000;
+    const int s_passes = 20;
+
+    const std::string s_templates[10][3] = {
+        { " _ ", "| |", "|_|" },
+        { "   ", "  |", "  |" },
+        { " _ ", " _|", "|_ " },
+        { " _ ", " _|", " _|" },
+        { "   ", "|_|", "  |" },
+        { " _ ", "|_ ", " _|" },
+        { " _ ", "|_ ", "|_|" },
+        { " _ ", "  |", "  |" },
+        { " _ ", "|_|", "|_|" },
+        { " _ ", "|_|", " _|" }
+    };
+
+    struct Entry
+    {
+        std::string lines[3];
+    };
+
+    std::vector<Entry> GenerateEntries()
+    {
+        std::mt19937 random(42);
+        std::uniform_int_distribution<int> digit(0, 9);
+        std::vector<Entry> entries(s_entries);
+        for (Entry& entry : entries)
+        {
+            for (size_t i = 0; i < g_accountDigits; ++i)
+            {
+                const int value = digit(random);
+                for (int row = 0; row < 3; ++row)
+                {
+                    entry.lines[row] += s_templates[value][row];
+                }
+            }
+        }
+        return entries;
+    }
+
+    bool DecodeNaive(const Entry& entry, char* digits)
+    {
+        bool legible = true;
+        for (size_t i = 0; i < g_accountDigits; ++i)
+        {
+            digits[i] = g_illegibleDigit;
+            for (int value = 0; value < 10; ++value)
+            {
+                if (entry.lines[0].substr(i * 3, 3) == s_templates[value][0] &&
+                    entry.lines[1].substr(i * 3, 3) == s_templates[value][1] &&
+                    entry.lines[2].substr(i * 3, 3) == s_templates[value][2])
+                {
+                    digits[i] = static_cast<char>('0' + value);
+                    break;
+                }
+            }
+            legible &= digits[i] != g_illegibleDigit;
+        }
+        return legible;
+    }
+
+    template <typename Decoder>
+    double Measure(const std::vector<Entry>& entries, Decoder decode)
+    {
+        size_t checksum = 0;
+        char digits[g_accountDigits];
+        auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < s_passes; ++pass)
+        {
+            for (const Entry& entry : entries)
+            {
+                EXPECT_TRUE(decode(entry, digits));
+                checksum += digits[pass % g_accountDigits];
+            }
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        EXPECT_NE(0u, checksum);
+        return entries.size() * s_passes / seconds;
+    }
+}
+
+TEST(OcrDecoderBenchmark, DISABLED_EntriesPerSecond)
+{
+    const std::vector<Entry> entries = GenerateEntries();
+
+    const double naive = Measure(entries, DecodeNaive);
+    const double masked = Measure(entries, [](const Entry& entry, char* digits)
+    {
+        return DecodeEntry(entry.lines[0], entry.lines[1], entry.lines[2], digits);
+    });
+
+    std::cout << "Naive: " << naive << " entries/s" << std::endl;
+    std::cout << "Masks: " << masked << " entries/s" << std::endl;
+}
@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <bit>
+
+#include "ocrfuzzydecoder.h"
+
+namespace
+{
+    const size_t s_maskCount = OcrDecoderDetail::s_maskCount;
+    const int s_segmentCount = 9;
+
+    struct NearestTable
+    {
+        FuzzyDigit cells[s_maskCount];
+    };
+
+    constexpr NearestTable MakeNearestTable()
+    {
+        NearestTable table = {};
+        for (size_t mask = 0; mask < s_maskCount; ++mask)
+        {
+            int distances[10] = {};
+            int best = s_segmentCount + 1;
+            for (int digit = 0; digit < 10; ++digit)
+            {
+                distances[digit] = std::popcount(static_cast<unsigned>(mask ^ GetGlyphMask(digit)));
+                best = std::min(best, distances[digit]);
+            }
+
+            FuzzyDigit& cell = table.cells[mask];
+            int second = s_segmentCount + 1;
+            for (int digit = 9; digit >= 0; --digit)
+            {
+                if (distances[digit] == best)
+                {
+                    cell.candidates |= static_cast<uint16_t>(1 << digit);
+                    cell.digit = static_cast<char>('0' + digit);
+                }
+                else
+                {
+                    second = std::min(second, distances[digit]);
+                }
+            }
+            cell.distance = static_cast<uint8_t>(best);
+            // Margin to the next nearest glyph, relative to the distances
+            if (std::popcount(cell.candidates) == 1)
+            {
+                cell.confidence = static_cast<float>(second - best) / static_cast<float>(second + best);
+            }
+        }
+        return table;
+    }
+
+    constexpr NearestTable s_nearestTable = MakeNearestTable();
+
+    // Glyphs are their own only nearest ones
+    constexpr bool AreGlyphsExact()
+    {
+        for (int digit = 0; digit < 10; ++digit)
+        {
+            const FuzzyDigit& cell = s_nearestTable.cells[GetGlyphMask(digit)];
+            if (cell.digit != '0' + digit || cell.distance != 0 || cell.confidence != 1 || cell.candidates != 1 << digit)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(AreGlyphsExact(), "Glyphs must decode exactly.");
+}
+
+FuzzyDigit DecodeMaskFuzzy(uint16_t mask)
+{
+    return s_nearestTable.cells[mask % s_maskCount];
+}
+
+float DecodeEntryFuzzy(std::string_view top, std::string_view middle, std::string_view bottom, FuzzyDigit* digits)
+{
+    uint16_t masks[g_accountDigits];
+    GetEntryMasks(top, middle, bottom, masks);
+    float confidence = 1;
+    for (size_t i = 0; i < g_accountDigits; ++i)
+    {
+        digits[i] = DecodeMaskFuzzy(masks[i]);
+        confidence = std::min(confidence, digits[i].confidence);
+    }
+    return confidence;
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include "ocrdecoder.h"
+
+/*
+ * Tolerant decoder of the smudged scans.
+ *
+ * A cell, which matches no glyph exactly, is read as the nearest one: the Hamming distance to every glyph
+ * is the popcount of the XOR of the masks. Cells have 512 masks only, so the nearest glyphs and the confidence
+ * of every mask are found at compile time, and decoding a cell is a single lookup like the exact DecodeMask.
+*/
+
+struct FuzzyDigit
+{
+    char digit; // Nearest digit, the least one if several are equally near
+    uint8_t distance; // Segments to the nearest glyph, 0 for the exact match
+    uint16_t candidates; // Bit d for every digit at the nearest distance, more than one bit for an ambiguous cell
+    float confidence; // 1 for the exact match, down to 0 for an ambiguous cell
+};
+
+// Nearest digit of the cell mask
+FuzzyDigit DecodeMaskFuzzy(uint16_t mask);
+// Decodes the three lines of the entry into g_accountDigits nearest digits.
+// Returns the lowest confidence of them.
+float DecodeEntryFuzzy(std::string_view top, std::string_view middle, std::string_view bottom, FuzzyDigit* digits);
@@ -0,0 +1,83 @@
+// Entries per second of the fuzzy decoder against the exact DecodeEntry on a noisy scan,
+// where every entry has a smudged cell.
+// It is disabled by default, run it with --gtest_also_run_disabled_tests.
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "ocrfuzzydecoder.h"
+
+namespace
+{
+    const size_t s_entries = 100000;
+    const int s_passes = 20;
+
+    struct Entry
+    {
+        std::string lines[3];
+    };
+
+    std::vector<Entry> GenerateNoisyEntries()
+    {
+        std::mt19937 random(42);
+        std::uniform_int_distribution<int> digit(0, 9);
+        std::uniform_int_distribution<size_t> character(0, g_entryWidth * 3 - 1);
+        std::vector<Entry> entries(s_entries);
+        for (Entry& entry : entries)
+        {
+            for (size_t i = 0; i < g_accountDigits; ++i)
+            {
+                const int value = digit(random);
+                for (int row = 0; row < 3; ++row)
+                {
+                    entry.lines[row] += g_glyphs[value][row];
+                }
+            }
+            const size_t noise = character(random);
+            char& flipped = entry.lines[noise / g_entryWidth][noise % g_entryWidth];
+            flipped = flipped == ' ' ? '|' : ' ';
+        }
+        return entries;
+    }
+
+    template <typename Decoder>
+    double Measure(const std::vector<Entry>& entries, Decoder decode)
+    {
+        size_t checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < s_passes; ++pass)
+        {
+            for (const Entry& entry : entries)
+            {
+                checksum += decode(entry, pass % g_accountDigits);
+            }
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        EXPECT_NE(0u, checksum);
+        return entries.size() * s_passes / seconds;
+    }
+}
+
+TEST(OcrFuzzyDecoderBenchmark, DISABLED_NoisyEntriesPerSecond)
+{
+    const std::vector<Entry> entries = GenerateNoisyEntries();
+
+    const double exact = Measure(entries, [](const Entry& entry, size_t position)
+    {
+        char digits[g_accountDigits];
+        DecodeEntry(entry.lines[0], entry.lines[1], entry.lines[2], digits);
+        return static_cast<size_t>(digits[position]);
+    });
+    const double fuzzy = Measure(entries, [](const Entry& entry, size_t position)
+    {
+        FuzzyDigit digits[g_accountDigits];
+        DecodeEntryFuzzy(entry.lines[0], entry.lines[1], entry.lines[2], digits);
+        return static_cast<size_t>(digits[position].digit);
+    });
+
+    std::cout << "Exact: " << exact / 1e6 << "M entries/s" << std::endl;
+    std::cout << "Fuzzy: " << fuzzy / 1e6 << "M entries/s, " << exact / fuzzy << " times slower" << std::endl;
+    EXPECT_LT(exact / fuzzy, 2.0);
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "ocrfuzzydecoder.h"
+
+namespace
+{
+    FuzzyDigit DecodeCell(std::string_view top, std::string_view middle, std::string_view bottom)
+    {
+        return DecodeMaskFuzzy(GetCellMask(top, middle, bottom, 0));
+    }
+}
+
+TEST(OcrFuzzyDecoderTest, DecodesGlyphsExactly)
+{
+    for (int digit = 0; digit < 10; ++digit)
+    {
+        const FuzzyDigit decoded = DecodeMaskFuzzy(GetGlyphMask(digit));
+        EXPECT_EQ('0' + digit, decoded.digit);
+        EXPECT_EQ(0, decoded.distance);
+        EXPECT_EQ(1 << digit, decoded.candidates);
+        EXPECT_FLOAT_EQ(1.0f, decoded.confidence);
+    }
+}
+
+TEST(OcrFuzzyDecoderTest, DecodesSmudgedCellAsNearestGlyph)
+{
+    const FuzzyDigit eight = DecodeCell("   ", "|_|", "|_|");
+    EXPECT_EQ('8', eight.digit);
+    EXPECT_EQ(1, eight.distance);
+    EXPECT_EQ(1 << 8, eight.candidates);
+
+    const FuzzyDigit zero = DecodeCell(" _ ", "| |", "| |");
+    EXPECT_EQ('0', zero.digit);
+    EXPECT_EQ(1, zero.distance);
+}
+
+TEST(OcrFuzzyDecoderTest, ConfidenceFallsWithDistance)
+{
+    const FuzzyDigit one = DecodeCell("|  ", "  |", "  |");
+    EXPECT_EQ('1', one.digit);
+    EXPECT_GT(one.confidence, 0.0f);
+    EXPECT_LT(one.confidence, 1.0f);
+}
+
+TEST(OcrFuzzyDecoderTest, ListsCandidatesOfAmbiguousCell)
+{
+    const FuzzyDigit decoded = DecodeCell(" _ ", "|_|", "  |");
+    EXPECT_EQ('4', decoded.digit);
+    EXPECT_EQ((1 << 4) | (1 << 9), decoded.candidates);
+    EXPECT_FLOAT_EQ(0.0f, decoded.confidence);
+}
+
+TEST(OcrFuzzyDecoderTest, DecodesSmudgedEntry)
+{
+    FuzzyDigit digits[g_accountDigits];
+    const float confidence = DecodeEntryFuzzy("    _  _     _  _  _  _  _ ",
+                                              "  | _| _||_||_ |_   ||_||_|",
+                                              "  ||_  _|  | _|| |  ||_| _|", digits);
+    std::string number;
+    for (const FuzzyDigit& digit : digits)
+    {
+        number += digit.digit;
+    }
+    EXPECT_EQ("123456789", number);
+    EXPECT_EQ(1, digits[5].distance);
+    EXPECT_LT(confidence, 1.0f);
+}
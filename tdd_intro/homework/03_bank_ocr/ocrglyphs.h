@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/*
+ * Glyphs of the bank OCR digits, all known at compile time.
+ *
+ * Each 3x3 cell of a digit is packed into a 9-bit mask: one bit for each character, which is not a space,
+ * row by row from the top left corner. Masks of the glyphs and the rendered entries are constexpr,
+ * so the tables built of them take no static initialization and no heap.
+*/
+
+const size_t g_accountDigits = 9;
+const size_t g_glyphSize = 3;
+const size_t g_entryWidth = g_accountDigits * g_glyphSize;
+
+inline constexpr std::string_view g_glyphs[10][g_glyphSize] = {
+    { " _ ", "| |", "|_|" },
+    { "   ", "  |", "  |" },
+    { " _ ", " _|", "|_ " },
+    { " _ ", " _|", " _|" },
+    { "   ", "|_|", "  |" },
+    { " _ ", "|_ ", " _|" },
+    { " _ ", "|_ ", "|_|" },
+    { " _ ", "  |", "  |" },
+    { " _ ", "|_|", "|_|" },
+    { " _ ", "|_|", " _|" }
+};
+
+// Mask of the cell starting at the given column of the three lines.
+constexpr uint16_t GetCellMask(std::string_view top, std::string_view middle, std::string_view bottom, size_t column)
+{
+    uint16_t mask = 0;
+    const std::string_view lines[] = { top, middle, bottom };
+    for (size_t row = 0; row < g_glyphSize; ++row)
+    {
+        for (size_t i = 0; i < g_glyphSize; ++i)
+        {
+            const size_t position = column + i;
+            if (position < lines[row].size() && lines[row][position] != ' ')
+            {
+                mask |= static_cast<uint16_t>(1 << (row * g_glyphSize + i));
+            }
+        }
+    }
+    return mask;
+}
+
+constexpr uint16_t GetGlyphMask(int digit)
+{
+    return GetCellMask(g_glyphs[digit][0], g_glyphs[digit][1], g_glyphs[digit][2], 0);
+}
+
+// Three lines of an entry, each one of g_entryWidth characters and the terminating zero
+struct EntryText
+{
+    char lines[g_glyphSize][g_entryWidth + 1];
+};
+
+// Renders up to g_accountDigits digit characters, the other characters and the missing digits are left blank
+constexpr EntryText RenderEntry(std::string_view digits)
+{
+    EntryText text = {};
+    for (size_t row = 0; row < g_glyphSize; ++row)
+    {
+        for (size_t i = 0; i < g_entryWidth; ++i)
+        {
+            const size_t position = i / g_glyphSize;
+            const char digit = position < digits.size() ? digits[position] : ' ';
+            text.lines[row][i] = digit >= '0' && digit <= '9' ? g_glyphs[digit - '0'][row][i % g_glyphSize] : ' ';
+        }
+    }
+    return text;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstring>
+#include <string_view>
+#include "ocrdecoder.h"
+
+/*
+ * Streaming parser of the bank OCR scanner files.
+ *
+ * Each entry takes 4 lines: 3 lines of glyphs and a blank one. The parser walks the lines right in the given
+ * memory (e.g. MappedFile), without copying them, and passes every decoded account number to the handler.
+ * Lines may end with "\n" or "\r\n" and may be shorter than 27 characters. The blank line may be missing
+ * after the last entry, and the last entry may lack some of its lines, they are decoded as blank then.
+ * Extra blank lines at the end of the data are skipped.
+*/
+
+struct AccountNumber
+{
+    char digits[g_accountDigits];
+    uint16_t masks[g_accountDigits]; // Cells as read, to recover the wrong digits (see CheckAccount)
+    bool legible; // No illegible digits, see DecodeMasks
+};
+
+namespace OcrParserDetail
+{
+    // Returns the line at the position without the line break, moves the position after the break
+    inline std::string_view NextLine(const char*& position, const char* end)
+    {
+        const char* lineEnd = static_cast<const char*>(std::memchr(position, '\n', end - position));
+        const char* next = lineEnd ? lineEnd + 1 : end;
+        if (!lineEnd)
+        {
+            lineEnd = end;
+        }
+        if (lineEnd > position && lineEnd[-1] == '\r')
+        {
+            --lineEnd;
+        }
+        std::string_view line(position, lineEnd - position);
+        position = next;
+        return line;
+    }
+}
+
+// Calls handler(const AccountNumber&) for every entry of the data in order. Returns the number of entries.
+template <typename Handler>
+size_t ParseEntries(std::string_view data, Handler&& handler)
+{
+    const char* position = data.data();
+    const char* const end = data.data() + data.size();
+    size_t entries = 0;
+    AccountNumber number;
+    while (position != end)
+    {
+        const std::string_view top = OcrParserDetail::NextLine(position, end);
+        const std::string_view middle = OcrParserDetail::NextLine(position, end);
+        const std::string_view bottom = OcrParserDetail::NextLine(position, end);
+        OcrParserDetail::NextLine(position, end); // Blank line between the entries
+        if (top.empty() && middle.empty() && bottom.empty())
+        {
+            continue;
+        }
+
+        GetEntryMasks(top, middle, bottom, number.masks);
+        number.legible = DecodeMasks(number.masks, number.digits);
+        handler(number);
+        ++entries;
+    }
+    return entries;
+}
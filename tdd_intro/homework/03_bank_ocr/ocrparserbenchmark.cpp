@@ -0,0 +1,50 @@
+// Parsing speed of the memory-mapped scanner file of 1 GB.
+// It is disabled by default, run it with --gtest_also_run_disabled_tests.
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "mappedfile.h"
+#include "ocrcorpus.h"
+#include "ocrparser.h"
+
+namespace
+{
+    const size_t s_fixtureSize = size_t(1) << 30;
+
+    // Writes random entries into the file, returns their number
+    size_t GenerateFixture(const std::string& path)
+    {
+        CorpusOptions options;
+        options.entries = s_fixtureSize / g_renderedEntrySize;
+        std::ofstream file(path, std::ios::binary);
+        WriteCorpus(file, options);
+        return options.entries;
+    }
+}
+
+TEST(OcrParserBenchmark, DISABLED_ParseMappedFile)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "ocrparserbenchmark.txt").string();
+    const size_t generated = GenerateFixture(path);
+
+    {
+        auto start = std::chrono::steady_clock::now();
+        MappedFile file(path);
+        size_t legible = 0;
+        const size_t entries = ParseEntries(file.GetData(), [&legible](const AccountNumber& number)
+        {
+            legible += number.legible;
+        });
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        EXPECT_EQ(generated, entries);
+        EXPECT_EQ(generated, legible);
+        std::cout << "Parsed " << entries << " entries: " << file.GetData().size() / seconds / (1 << 30) << " GB/s, "
+                  << entries / seconds << " entries/s" << std::endl;
+    }
+    std::remove(path.c_str());
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "mappedfile.h"
+#include "ocrparser.h"
+
+namespace
+{
+    const std::string s_entry123456789 = "    _  _     _  _  _  _  _ \n"
+                                         "  | _| _||_||_ |_   ||_||_|\n"
+                                         "  ||_  _|  | _||_|  ||_| _|\n"
+                                         "\n";
+    const std::string s_entryAll1 = "                           \n"
+                                    "  |  |  |  |  |  |  |  |  |\n"
+                                    "  |  |  |  |  |  |  |  |  |\n"
+                                    "\n";
+
+    std::vector<std::string> ParseAll(std::string_view data)
+    {
+        std::vector<std::string> numbers;
+        ParseEntries(data, [&numbers](const AccountNumber& number)
+        {
+            numbers.emplace_back(number.digits, g_accountDigits);
+        });
+        return numbers;
+    }
+
+    std::string ToCrLf(const std::string& data)
+    {
+        std::string converted;
+        for (char character : data)
+        {
+            if (character == '\n')
+            {
+                converted += '\r';
+            }
+            converted += character;
+        }
+        return converted;
+    }
+}
+
+TEST(OcrParserTest, ParsesEntriesInOrder)
+{
+    EXPECT_EQ(std::vector<std::string>({ "123456789", "111111111" }), ParseAll(s_entry123456789 + s_entryAll1));
+}
+
+TEST(OcrParserTest, ReturnsNumberOfEntries)
+{
+    EXPECT_EQ(2u, ParseEntries(s_entryAll1 + s_entryAll1, [](const AccountNumber&) { }));
+    EXPECT_EQ(0u, ParseEntries("", [](const AccountNumber&) { }));
+}
+
+TEST(OcrParserTest, ParsesCrLfLines)
+{
+    EXPECT_EQ(std::vector<std::string>({ "123456789", "111111111" }), ParseAll(ToCrLf(s_entry123456789 + s_entryAll1)));
+}
+
+TEST(OcrParserTest, ParsesLinesWithTrimmedSpaces)
+{
+    const std::string data = "\n"
+                             "  |  |  |  |  |  |  |  |  |\n"
+                             "  |  |  |  |  |  |  |  |  |\n"
+                             "\n"
+                             "    _  _     _  _  _  _  _\n"
+                             "  | _| _||_||_ |_   ||_||_|\n"
+                             "  ||_  _|  | _||_|  ||_| _|\n";
+    EXPECT_EQ(std::vector<std::string>({ "111111111", "123456789" }), ParseAll(data));
+}
+
+TEST(OcrParserTest, ParsesLastEntryWithoutLineBreaks)
+{
+    const std::string data = s_entryAll1 + s_entry123456789.substr(0, s_entry123456789.size() - 2);
+    EXPECT_EQ(std::vector<std::string>({ "111111111", "123456789" }), ParseAll(data));
+}
+
+TEST(OcrParserTest, SkipsBlankLinesAtEnd)
+{
+    EXPECT_EQ(std::vector<std::string>({ "111111111" }), ParseAll(s_entryAll1 + "\n\n\r\n\n\n"));
+}
+
+TEST(OcrParserTest, MarksEntriesWithIllegibleDigits)
+{
+    std::vector<AccountNumber> numbers;
+    ParseEntries(s_entryAll1 + "\n  |\n  |\n", [&numbers](const AccountNumber& number) { numbers.push_back(number); });
+
+    ASSERT_EQ(2u, numbers.size());
+    EXPECT_TRUE(numbers[0].legible);
+    EXPECT_FALSE(numbers[1].legible);
+    EXPECT_EQ("1????????", std::string(numbers[1].digits, g_accountDigits));
+}
+
+TEST(MappedFileTest, MapsWholeFile)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "mappedfiletest_whole.txt").string();
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << s_entry123456789;
+    }
+
+    {
+        MappedFile mapped(path);
+        EXPECT_EQ(s_entry123456789, mapped.GetData());
+        EXPECT_EQ(std::vector<std::string>({ "123456789" }), ParseAll(mapped.GetData()));
+    }
+    std::remove(path.c_str());
+}
+
+TEST(MappedFileTest, MapsEmptyFile)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "mappedfiletest_empty.txt").string();
+    std::ofstream(path).close();
+
+    {
+        MappedFile mapped(path);
+        EXPECT_TRUE(mapped.GetData().empty());
+    }
+    std::remove(path.c_str());
+}
+
+TEST(MappedFileTest, ThrowsIfFileIsMissing)
+{
+    EXPECT_THROW(MappedFile("/no/such/dir/scanner.txt"), std::runtime_error);
+}
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OCR_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "ocrpipeline.h"
+
+namespace
+{
+    const size_t s_linesPerEntry = 4;
+    const size_t s_slotsPerThread = 4;
+
+    // Returns the position after the given number of line breaks, or the end if there are not so many
+    const char* SkipLines(const char* position, const char* end, size_t lines)
+    {
+#ifdef OCR_USE_SSE2
+        // Counts the line breaks of 16 characters at once, while the searched one is not among them
+        const __m128i breaks = _mm_set1_epi8('\n');
+        while (end - position >= 16)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(position));
+            const unsigned found = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, breaks)));
+            const size_t count = static_cast<size_t>(std::popcount(found));
+            if (count >= lines)
+            {
+                break;
+            }
+            lines -= count;
+            position += 16;
+        }
+#endif
+        for (; lines > 0 && position != end; --lines)
+        {
+            const char* lineEnd = static_cast<const char*>(std::memchr(position, '\n', end - position));
+            position = lineEnd ? lineEnd + 1 : end;
+        }
+        return position;
+    }
+
+    size_t GetThreads(size_t threads)
+    {
+        return threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+ParallelOcrParser::ParallelOcrParser(std::string_view data, size_t threads, size_t entriesPerChunk)
+    : m_position(data.data())
+    , m_end(data.data() + data.size())
+    , m_linesPerChunk(std::max<size_t>(entriesPerChunk, 1) * s_linesPerEntry)
+    , m_workers(GetThreads(threads), s_slotsPerThread,
+                [this](std::string_view& chunk) { return TakeChunk(chunk); },
+                [](std::string_view chunk, std::vector<AccountNumber>& numbers)
+                {
+                    numbers.clear();
+                    ParseEntries(chunk, [&numbers](const AccountNumber& number) { numbers.push_back(number); });
+                })
+{
+}
+
+ParallelOcrParser::~ParallelOcrParser()
+{
+}
+
+bool ParallelOcrParser::NextChunk(std::vector<AccountNumber>& numbers)
+{
+    return m_workers.Next(numbers);
+}
+
+size_t ParallelOcrParser::GetThreadCount() const
+{
+    return m_workers.GetThreadCount();
+}
+
+bool ParallelOcrParser::TakeChunk(std::string_view& chunk)
+{
+    if (m_position == m_end)
+    {
+        return false;
+    }
+    const char* begin = m_position;
+    m_position = SkipLines(m_position, m_end, m_linesPerChunk);
+    chunk = std::string_view(begin, m_position - begin);
+    return true;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <string_view>
+#include <vector>
+#include "ocrparser.h"
+#include "orderedchunks.h"
+
+/*
+ * Parallel version of ParseEntries for big scanner files.
+ *
+ * The data is split into chunks of whole entries (4 lines each), which are decoded by the worker threads
+ * independently. Each worker takes the next chunk by skipping its lines from the end of the previous one,
+ * which is much faster than decoding, and decodes it outside of the lock.
+ * Decoded chunks are returned by NextChunk in the input order: a chunk decoded early waits in the reorder buffer
+ * of limited size (see OrderedChunkWorkers). Result is the same as the one of ParseEntries for any number of threads.
+*/
+
+class ParallelOcrParser
+{
+public:
+    static const size_t s_entriesPerChunk = 16 * 1024;
+
+    // Threads start right away. Zero threads mean one per hardware thread.
+    ParallelOcrParser(std::string_view data, size_t threads = 0, size_t entriesPerChunk = s_entriesPerChunk);
+    // Stops the workers, the rest of the data is not decoded.
+    ~ParallelOcrParser();
+    ParallelOcrParser(const ParallelOcrParser&) = delete;
+    ParallelOcrParser& operator=(const ParallelOcrParser&) = delete;
+
+    // Replaces the numbers with the next chunk in the input order, waits until it is decoded.
+    // Returns false when all the chunks are returned.
+    bool NextChunk(std::vector<AccountNumber>& numbers);
+
+    size_t GetThreadCount() const;
+
+private:
+    // Called by the workers under their lock
+    bool TakeChunk(std::string_view& chunk);
+
+private:
+    const char* m_position; // Beginning of the next chunk to be taken
+    const char* const m_end;
+    const size_t m_linesPerChunk;
+    OrderedChunkWorkers<std::string_view, std::vector<AccountNumber>> m_workers;
+};
+
+// Calls handler(const AccountNumber&) for every entry of the data in order, decoding them on the given number
+// of threads (see ParallelOcrParser). Returns the number of entries.
+template <typename Handler>
+size_t ParseEntriesParallel(std::string_view data, size_t threads, Handler&& handler)
+{
+    ParallelOcrParser parser(data, threads);
+    std::vector<AccountNumber> numbers;
+    size_t entries = 0;
+    while (parser.NextChunk(numbers))
+    {
+        for (const AccountNumber& number : numbers)
+        {
+            handler(number);
+        }
+        entries += numbers.size();
+    }
+    return entries;
+}
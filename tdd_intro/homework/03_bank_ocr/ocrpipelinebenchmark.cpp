@@ -0,0 +1,71 @@
+// Scaling of the parallel parser from one thread to one per hardware thread, on the memory-mapped file of 1 GB.
+// It is disabled by default, run it with --gtest_also_run_disabled_tests.
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "mappedfile.h"
+#include "ocrcorpus.h"
+#include "ocrpipeline.h"
+
+namespace
+{
+    const size_t s_fixtureSize = size_t(1) << 30;
+
+    // Writes random entries into the file
+    void GenerateFixture(const std::string& path)
+    {
+        CorpusOptions options;
+        options.entries = s_fixtureSize / g_renderedEntrySize;
+        std::ofstream file(path, std::ios::binary);
+        WriteCorpus(file, options);
+    }
+}
+
+TEST(OcrPipelineBenchmark, DISABLED_ScalingWithThreads)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "ocrpipelinebenchmark.txt").string();
+    GenerateFixture(path);
+
+    {
+        MappedFile file(path);
+        const std::string_view data = file.GetData();
+        const size_t expected = ParseEntries(data, [](const AccountNumber&) { });
+
+        const size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+        // Powers of two below the number of hardware threads, then all of them
+        std::vector<size_t> threadCounts;
+        for (size_t threads = 1; threads < maxThreads; threads *= 2)
+        {
+            threadCounts.push_back(threads);
+        }
+        threadCounts.push_back(maxThreads);
+
+        double single = 0;
+        for (size_t threads : threadCounts)
+        {
+            size_t legible = 0;
+            auto start = std::chrono::steady_clock::now();
+            const size_t entries = ParseEntriesParallel(data, threads, [&legible](const AccountNumber& number)
+            {
+                legible += number.legible;
+            });
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (threads == 1)
+            {
+                single = seconds;
+            }
+
+            EXPECT_EQ(expected, entries);
+            EXPECT_EQ(expected, legible);
+            std::cout << threads << " threads: " << data.size() / seconds / (1 << 20) << " MB/s, "
+                      << entries / seconds / 1e6 << "M entries/s, speedup " << single / seconds << std::endl;
+        }
+    }
+    std::remove(path.c_str());
+}
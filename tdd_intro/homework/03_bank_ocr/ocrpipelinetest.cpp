@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "ocrpipeline.h"
+
+namespace
+{
+    // Random entries with illegible digits, CRLF and trimmed lines, and blank entries in between
+    std::string GenerateData(size_t entries)
+    {
+        std::mt19937 random(7);
+        std::uniform_int_distribution<int> digit(0, 10); // 10 is an illegible one
+        std::uniform_int_distribution<int> variant(0, 15);
+        std::string data;
+        for (size_t i = 0; i < entries; ++i)
+        {
+            const int kind = variant(random);
+            const char* lineBreak = kind == 1 ? "\r\n" : "\n";
+            if (kind == 2)
+            {
+                data += "\n\n\n\n";
+            }
+            int digits[g_accountDigits];
+            for (int& value : digits)
+            {
+                value = digit(random);
+            }
+            for (int row = 0; row < 3; ++row)
+            {
+                std::string line;
+                for (int value : digits)
+                {
+                    line += value == 10 ? "|||" : g_glyphs[value][row];
+                }
+                if (kind == 3)
+                {
+                    line.erase(line.find_last_not_of(' ') + 1);
+                }
+                data += line + lineBreak;
+            }
+            data += lineBreak;
+        }
+        return data;
+    }
+
+    std::string ToString(const AccountNumber& number)
+    {
+        return std::string(number.digits, g_accountDigits) + (number.legible ? " " : " ILL");
+    }
+
+    std::vector<std::string> ParseSequential(std::string_view data)
+    {
+        std::vector<std::string> numbers;
+        ParseEntries(data, [&numbers](const AccountNumber& number) { numbers.push_back(ToString(number)); });
+        return numbers;
+    }
+
+    std::vector<std::string> ParseChunked(std::string_view data, size_t threads, size_t entriesPerChunk)
+    {
+        std::vector<std::string> numbers;
+        ParallelOcrParser parser(data, threads, entriesPerChunk);
+        std::vector<AccountNumber> chunk;
+        while (parser.NextChunk(chunk))
+        {
+            for (const AccountNumber& number : chunk)
+            {
+                numbers.push_back(ToString(number));
+            }
+        }
+        return numbers;
+    }
+}
+
+TEST(OcrPipelineTest, ReturnsNothingForEmptyData)
+{
+    ParallelOcrParser parser("", 2);
+    std::vector<AccountNumber> chunk;
+    EXPECT_FALSE(parser.NextChunk(chunk));
+    EXPECT_FALSE(parser.NextChunk(chunk));
+}
+
+TEST(OcrPipelineTest, StartsThreadPerHardwareThreadByDefault)
+{
+    ParallelOcrParser parser("");
+    EXPECT_EQ(std::max(1u, std::thread::hardware_concurrency()), parser.GetThreadCount());
+}
+
+TEST(OcrPipelineTest, SplitsDataIntoChunksOfWholeEntries)
+{
+    const std::string data = GenerateData(10);
+    ParallelOcrParser parser(data, 1, 4);
+    std::vector<AccountNumber> chunk;
+    ASSERT_TRUE(parser.NextChunk(chunk));
+    EXPECT_LE(chunk.size(), 4u);
+}
+
+TEST(OcrPipelineTest, OutputIsSameAsSequentialForAnyThreadsAndChunks)
+{
+    const std::string data = GenerateData(5000);
+    const std::vector<std::string> expected = ParseSequential(data);
+    ASSERT_GT(expected.size(), 4000u);
+
+    for (size_t threads : { 1, 2, 3, 8 })
+    {
+        for (size_t entriesPerChunk : { 1, 3, 64, 10000 })
+        {
+            EXPECT_EQ(expected, ParseChunked(data, threads, entriesPerChunk)) << threads << " threads, "
+                << entriesPerChunk << " entries per chunk";
+        }
+    }
+}
+
+TEST(OcrPipelineTest, HandsEntriesInOrder)
+{
+    const std::string data = GenerateData(3000);
+    const std::vector<std::string> expected = ParseSequential(data);
+
+    std::vector<std::string> numbers;
+    const size_t entries = ParseEntriesParallel(data, 4, [&numbers](const AccountNumber& number)
+    {
+        numbers.push_back(ToString(number));
+    });
+    EXPECT_EQ(expected.size(), entries);
+    EXPECT_EQ(expected, numbers);
+}
+
+TEST(OcrPipelineTest, StopsWithoutReadingAllChunks)
+{
+    const std::string data = GenerateData(3000);
+    ParallelOcrParser parser(data, 4, 1);
+    std::vector<AccountNumber> chunk;
+    EXPECT_TRUE(parser.NextChunk(chunk));
+}
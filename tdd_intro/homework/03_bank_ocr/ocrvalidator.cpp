@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <vector>
+
+#include "ocrvalidator.h"
+
+namespace
+{
+    const size_t s_maskCount = 512;
+    const size_t s_segmentCount = 9;
+    const int s_modulus = 11;
+
+    // Digits, which differ from the cell by one segment: bit d for digit d
+    struct NeighbourTable
+    {
+        uint16_t digits[s_maskCount];
+    };
+
+    constexpr NeighbourTable MakeNeighbourTable()
+    {
+        NeighbourTable table = {};
+        for (size_t mask = 0; mask < s_maskCount; ++mask)
+        {
+            for (size_t segment = 0; segment < s_segmentCount; ++segment)
+            {
+                const char digit = DecodeMask(static_cast<uint16_t>(mask ^ (1 << segment)));
+                if (digit != g_illegibleDigit)
+                {
+                    table.digits[mask] |= static_cast<uint16_t>(1 << (digit - '0'));
+                }
+            }
+        }
+        return table;
+    }
+
+    constexpr NeighbourTable s_neighbourTable = MakeNeighbourTable();
+
+    static_assert(s_neighbourTable.digits[GetGlyphMask(1)] == 1 << 7, "One is a segment away from seven only.");
+
+    // Weight of the digit at the position, 9 for the leftmost one
+    int GetWeight(size_t position)
+    {
+        return static_cast<int>(g_accountDigits - position);
+    }
+
+    // Adds the neighbours of the cell, which make the checksum zero. Sum is the checksum without this position.
+    void AddCandidates(AccountCheck& check, uint16_t neighbours, size_t position, int sum)
+    {
+        const int weight = GetWeight(position);
+        for (int digit = 0; neighbours; ++digit, neighbours >>= 1)
+        {
+            if ((neighbours & 1) && (sum + weight * digit) % s_modulus == 0)
+            {
+                check.candidates[check.candidateCount++] = { static_cast<uint8_t>(position), static_cast<char>('0' + digit) };
+            }
+        }
+    }
+
+    std::string ApplyCorrection(const char* digits, const DigitCorrection& correction)
+    {
+        std::string number(digits, g_accountDigits);
+        number[correction.position] = correction.digit;
+        return number;
+    }
+}
+
+bool IsValidAccount(const char* digits)
+{
+    int sum = 0;
+    for (size_t i = 0; i < g_accountDigits; ++i)
+    {
+        sum += GetWeight(i) * (digits[i] - '0');
+    }
+    return sum % s_modulus == 0;
+}
+
+void CheckAccount(const AccountNumber& number, AccountCheck& check)
+{
+    std::copy(number.digits, number.digits + g_accountDigits, check.digits);
+    check.candidateCount = 0;
+
+    int sum = 0;
+    size_t illegibleCount = 0;
+    size_t illegiblePosition = 0;
+    for (size_t i = 0; i < g_accountDigits; ++i)
+    {
+        if (number.digits[i] == g_illegibleDigit)
+        {
+            ++illegibleCount;
+            illegiblePosition = i;
+            continue;
+        }
+        sum += GetWeight(i) * (number.digits[i] - '0');
+    }
+
+    if (illegibleCount == 0 && sum % s_modulus == 0)
+    {
+        check.status = AccountStatus::Valid;
+        return;
+    }
+
+    const NeighbourTable& table = s_neighbourTable;
+    if (illegibleCount == 1)
+    {
+        // Only the illegible cell may be fixed, the other digits stay
+        AddCandidates(check, table.digits[number.masks[illegiblePosition]], illegiblePosition, sum);
+    }
+    else if (illegibleCount == 0)
+    {
+        // Any digit may be fixed. Multiple of the modulus keeps the sum without the digit positive.
+        for (size_t i = 0; i < g_accountDigits; ++i)
+        {
+            const int others = sum - GetWeight(i) * (number.digits[i] - '0') + s_modulus * GetWeight(0) * 9;
+            AddCandidates(check, table.digits[number.masks[i]], i, others);
+        }
+    }
+
+    if (check.candidateCount == 1)
+    {
+        check.status = AccountStatus::Corrected;
+        check.digits[check.candidates[0].position] = check.candidates[0].digit;
+    }
+    else if (check.candidateCount > 1)
+    {
+        check.status = AccountStatus::Ambiguous;
+    }
+    else
+    {
+        check.status = illegibleCount ? AccountStatus::Illegible : AccountStatus::Error;
+    }
+}
+
+std::string FormatAccountCheck(const AccountCheck& check)
+{
+    std::string line(check.digits, g_accountDigits);
+    switch (check.status)
+    {
+    case AccountStatus::Valid:
+    case AccountStatus::Corrected:
+        break;
+    case AccountStatus::Illegible:
+        line += " ILL";
+        break;
+    case AccountStatus::Error:
+        line += " ERR";
+        break;
+    case AccountStatus::Ambiguous:
+    {
+        std::vector<std::string> candidates;
+        for (size_t i = 0; i < check.candidateCount; ++i)
+        {
+            candidates.push_back(ApplyCorrection(check.digits, check.candidates[i]));
+        }
+        std::sort(candidates.begin(), candidates.end());
+        line += " AMB [";
+        for (size_t i = 0; i < candidates.size(); ++i)
+        {
+            line += (i ? ", '" : "'") + candidates[i] + "'";
+        }
+        line += "]";
+        break;
+    }
+    }
+    return line;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "ocrparser.h"
+
+/*
+ * Checksum validation and error correction of the decoded account numbers.
+ *
+ * Valid number has (d1 + 2*d2 + ... + 9*d9) mod 11 == 0, where d1 is the rightmost digit.
+ * A number with illegible digits is ILL, a number with the wrong checksum is ERR. Both may be recovered,
+ * if the scanner missed or added one segment: every number, which differs from the read one by a single
+ * segment and is valid, is a candidate. One candidate replaces the read number, several make it AMB.
+ *
+ * Candidates are not searched by decoding and validating every flipped entry. A precomputed table gives
+ * the digits one segment away from every cell mask, and the checksum of a candidate is the one of
+ * the read number updated by the weight of the changed position.
+*/
+
+enum class AccountStatus
+{
+    Valid,
+    Corrected, // Was ILL or ERR, recovered by one segment
+    Illegible,
+    Error,
+    Ambiguous
+};
+
+// Single digit replaced in the read number
+struct DigitCorrection
+{
+    uint8_t position;
+    char digit;
+};
+
+struct AccountCheck
+{
+    // Every cell of 9 bits has at most 9 neighbours
+    static const size_t s_maxCandidates = g_accountDigits * 9;
+
+    AccountStatus status;
+    char digits[g_accountDigits]; // Read number, or the recovered one
+    size_t candidateCount;
+    DigitCorrection candidates[s_maxCandidates]; // Valid numbers one segment away from the read one
+};
+
+// Checksum test of the number of legible digits
+bool IsValidAccount(const char* digits);
+// Validates the decoded number and tries to recover it, if it is ILL or ERR.
+void CheckAccount(const AccountNumber& number, AccountCheck& check);
+// Result line of the check: "457508000", "664371495 ERR", "86110??36 ILL",
+// or "888888888 AMB ['888886888', '888888880', '888888988']" with the sorted candidates.
+std::string FormatAccountCheck(const AccountCheck& check);
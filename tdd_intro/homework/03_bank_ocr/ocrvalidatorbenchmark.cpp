@@ -0,0 +1,117 @@
+// Rate of the checked and corrected entries on a noisy scan: the neighbour tables against the brute force,
+// which flips every segment of the entry, decodes it again and validates the whole number.
+// It is disabled by default, run it with --gtest_also_run_disabled_tests.
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "ocrvalidator.h"
+
+namespace
+{
+    const size_t s_entries = 200000;
+
+    // Random numbers, a third of them with a segment missed or added by the scanner
+    std::string GenerateScan()
+    {
+        std::mt19937 random(42);
+        std::uniform_int_distribution<int> digit(0, 9);
+        std::uniform_int_distribution<size_t> character(0, g_entryWidth * 3 - 1);
+        std::string scan;
+        for (size_t i = 0; i < s_entries; ++i)
+        {
+            std::string lines[3];
+            for (size_t position = 0; position < g_accountDigits; ++position)
+            {
+                const int value = digit(random);
+                for (int row = 0; row < 3; ++row)
+                {
+                    lines[row] += g_glyphs[value][row];
+                }
+            }
+            if (i % 3 == 0)
+            {
+                const size_t noise = character(random);
+                char& flipped = lines[noise / g_entryWidth][noise % g_entryWidth];
+                flipped = flipped == ' ' ? '|' : ' ';
+            }
+            scan += lines[0] + "\n" + lines[1] + "\n" + lines[2] + "\n\n";
+        }
+        return scan;
+    }
+
+    // Counts the entries, which end up with a single valid number
+    size_t CheckWithTables(const std::string& scan)
+    {
+        size_t valid = 0;
+        AccountCheck check;
+        ParseEntries(scan, [&valid, &check](const AccountNumber& number)
+        {
+            CheckAccount(number, check);
+            valid += check.status == AccountStatus::Valid || check.status == AccountStatus::Corrected;
+        });
+        return valid;
+    }
+
+    size_t CheckWithBruteForce(const std::string& scan)
+    {
+        size_t valid = 0;
+        const char* position = scan.data();
+        const char* const end = scan.data() + scan.size();
+        while (position != end)
+        {
+            std::string lines[3];
+            for (std::string& line : lines)
+            {
+                line = std::string(OcrParserDetail::NextLine(position, end));
+            }
+            OcrParserDetail::NextLine(position, end);
+
+            char digits[g_accountDigits];
+            if (DecodeEntry(lines[0], lines[1], lines[2], digits) && IsValidAccount(digits))
+            {
+                ++valid;
+                continue;
+            }
+            size_t candidates = 0;
+            for (std::string& line : lines)
+            {
+                for (char& flipped : line)
+                {
+                    const char original = flipped;
+                    flipped = original == ' ' ? '|' : ' ';
+                    candidates += DecodeEntry(lines[0], lines[1], lines[2], digits) && IsValidAccount(digits);
+                    flipped = original;
+                }
+            }
+            valid += candidates == 1;
+        }
+        return valid;
+    }
+
+    template <typename Checker>
+    double Measure(const std::string& scan, Checker checker, size_t& valid)
+    {
+        auto start = std::chrono::steady_clock::now();
+        valid = checker(scan);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return s_entries / seconds;
+    }
+}
+
+TEST(OcrValidatorBenchmark, DISABLED_CorrectedEntriesPerSecond)
+{
+    const std::string scan = GenerateScan();
+
+    size_t bruteValid = 0;
+    size_t tableValid = 0;
+    const double brute = Measure(scan, CheckWithBruteForce, bruteValid);
+    const double tables = Measure(scan, CheckWithTables, tableValid);
+
+    EXPECT_EQ(bruteValid, tableValid);
+    std::cout << "Valid or corrected: " << tableValid << " of " << s_entries << std::endl;
+    std::cout << "Brute force: " << brute / 1e6 << "M entries/s" << std::endl;
+    std::cout << "Neighbour tables: " << tables / 1e6 << "M entries/s, " << tables / brute << " times faster" << std::endl;
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "ocrvalidator.h"
+
+namespace
+{
+    std::string Check(const std::string& top, const std::string& middle, const std::string& bottom)
+    {
+        AccountNumber number = {};
+        ParseEntries(top + "\n" + middle + "\n" + bottom + "\n\n", [&number](const AccountNumber& parsed) { number = parsed; });
+        AccountCheck check;
+        CheckAccount(number, check);
+        return FormatAccountCheck(check);
+    }
+
+    AccountStatus GetStatus(const std::string& top, const std::string& middle, const std::string& bottom)
+    {
+        AccountNumber number = {};
+        ParseEntries(top + "\n" + middle + "\n" + bottom + "\n\n", [&number](const AccountNumber& parsed) { number = parsed; });
+        AccountCheck check;
+        CheckAccount(number, check);
+        return check.status;
+    }
+}
+
+TEST(OcrValidatorTest, ValidatesChecksum)
+{
+    EXPECT_TRUE(IsValidAccount("345882865"));
+    EXPECT_TRUE(IsValidAccount("457508000"));
+    EXPECT_FALSE(IsValidAccount("664371495"));
+    EXPECT_FALSE(IsValidAccount("111111111"));
+}
+
+TEST(OcrValidatorTest, KeepsValidNumbers)
+{
+    EXPECT_EQ(AccountStatus::Valid, GetStatus("    _  _     _  _  _  _  _ ",
+                                              "  | _| _||_||_ |_   ||_||_|",
+                                              "  ||_  _|  | _||_|  ||_| _|"));
+    EXPECT_EQ("123456789", Check("    _  _     _  _  _  _  _ ",
+                                 "  | _| _||_||_ |_   ||_||_|",
+                                 "  ||_  _|  | _||_|  ||_| _|"));
+}
+
+TEST(OcrValidatorTest, CorrectsWrongChecksumBySingleSegment)
+{
+    EXPECT_EQ(AccountStatus::Corrected, GetStatus("                           ",
+                                                  "  |  |  |  |  |  |  |  |  |",
+                                                  "  |  |  |  |  |  |  |  |  |"));
+    EXPECT_EQ("711111111", Check("                           ",
+                                 "  |  |  |  |  |  |  |  |  |",
+                                 "  |  |  |  |  |  |  |  |  |"));
+    EXPECT_EQ("777777177", Check(" _  _  _  _  _  _  _  _  _ ",
+                                 "  |  |  |  |  |  |  |  |  |",
+                                 "  |  |  |  |  |  |  |  |  |"));
+    EXPECT_EQ("200800000", Check(" _  _  _  _  _  _  _  _  _ ",
+                                 " _|| || || || || || || || |",
+                                 "|_ |_||_||_||_||_||_||_||_|"));
+    EXPECT_EQ("333393333", Check(" _  _  _  _  _  _  _  _  _ ",
+                                 " _| _| _| _| _| _| _| _| _|",
+                                 " _| _| _| _| _| _| _| _| _|"));
+}
+
+TEST(OcrValidatorTest, ListsAmbiguousCandidates)
+{
+    EXPECT_EQ("888888888 AMB ['888886888', '888888880', '888888988']",
+              Check(" _  _  _  _  _  _  _  _  _ ",
+                    "|_||_||_||_||_||_||_||_||_|",
+                    "|_||_||_||_||_||_||_||_||_|"));
+    EXPECT_EQ("555555555 AMB ['555655555', '559555555']",
+              Check(" _  _  _  _  _  _  _  _  _ ",
+                    "|_ |_ |_ |_ |_ |_ |_ |_ |_ ",
+                    " _| _| _| _| _| _| _| _| _|"));
+    EXPECT_EQ("666666666 AMB ['666566666', '686666666']",
+              Check(" _  _  _  _  _  _  _  _  _ ",
+                    "|_ |_ |_ |_ |_ |_ |_ |_ |_ ",
+                    "|_||_||_||_||_||_||_||_||_|"));
+    EXPECT_EQ("999999999 AMB ['899999999', '993999999', '999959999']",
+              Check(" _  _  _  _  _  _  _  _  _ ",
+                    "|_||_||_||_||_||_||_||_||_|",
+                    " _| _| _| _| _| _| _| _| _|"));
+    EXPECT_EQ("490067715 AMB ['490067115', '490067719', '490867715']",
+              Check("    _  _  _  _  _  _     _ ",
+                    "|_||_|| || ||_   |  |  ||_ ",
+                    "  | _||_||_||_|  |  |  | _|"));
+}
+
+TEST(OcrValidatorTest, RecoversIllegibleDigit)
+{
+    EXPECT_EQ("123456789", Check("    _  _     _  _  _  _  _ ",
+                                 " _| _| _||_||_ |_   ||_||_|",
+                                 "  ||_  _|  | _||_|  ||_| _|"));
+    EXPECT_EQ("000000051", Check(" _     _  _  _  _  _  _    ",
+                                 "| || || || || || || ||_   |",
+                                 "|_||_||_||_||_||_||_| _|  |"));
+    EXPECT_EQ("490867715", Check("    _  _  _  _  _  _     _ ",
+                                 "|_||_|| ||_||_   |  |  | _ ",
+                                 "  | _||_||_||_|  |  |  | _|"));
+}
+
+TEST(OcrValidatorTest, MarksUnrecoverableNumbers)
+{
+    EXPECT_EQ("222222222 ERR", Check(" _  _  _  _  _  _  _  _  _ ",
+                                     " _| _| _| _| _| _| _| _| _|",
+                                     "|_ |_ |_ |_ |_ |_ |_ |_ |_ "));
+    EXPECT_EQ("86110??36 ILL", Check(" _  _        _  _  _  _  _ ",
+                                     "|_||_   |  || |  | _| _||_ ",
+                                     "|_||_|  |  ||_|| || | _||_|"));
+}
@@ -0,0 +1,145 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+ * Worker threads processing the chunks of some input independently and returning the results in the input order.
+ *
+ * Workers take the chunks one after another with the take function, which is called under the lock,
+ * so it may walk the input sequentially. Each chunk is processed outside of the lock, and its result goes
+ * to the reorder buffer, where Next picks it up in the input order. The buffer holds a limited number of results,
+ * workers wait when it is full, so memory use doesn't depend on the input size.
+ * Result objects are swapped between the workers, the buffer and the caller of Next, so their memory is reused.
+ *
+ * Next must be called by one thread. Take and process functions must not throw.
+*/
+
+template <typename Task, typename Result>
+class OrderedChunkWorkers
+{
+public:
+    // Sets the next chunk to be processed, returns false when there are no more.
+    using TakeFunction = std::function<bool(Task& task)>;
+    // Replaces the result with the one of the chunk.
+    using ProcessFunction = std::function<void(const Task& task, Result& result)>;
+
+    // Threads start right away, the functions must be usable already.
+    OrderedChunkWorkers(size_t threads, size_t slotsPerThread, TakeFunction take, ProcessFunction process)
+        : m_take(std::move(take))
+        , m_process(std::move(process))
+        , m_slots(threads * slotsPerThread)
+        , m_taken(0)
+        , m_returned(0)
+        , m_exhausted(false)
+        , m_stopped(false)
+    {
+        for (size_t i = 0; i < threads; ++i)
+        {
+            m_threads.emplace_back(&OrderedChunkWorkers::Work, this);
+        }
+    }
+
+    // Stops the workers, the rest of the chunks is not processed.
+    ~OrderedChunkWorkers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopped = true;
+        }
+        m_slotFree.notify_all();
+        for (auto& thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    OrderedChunkWorkers(const OrderedChunkWorkers&) = delete;
+    OrderedChunkWorkers& operator=(const OrderedChunkWorkers&) = delete;
+
+    // Replaces the result with the one of the next chunk in the input order, waits until it is processed.
+    // Returns false when all the chunks are returned.
+    bool Next(Result& result)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        Slot& slot = m_slots[m_returned % m_slots.size()];
+        // Everything is returned when no chunk is left to take and all the taken ones are returned
+        m_chunkReady.wait(lock, [this, &slot]() { return slot.ready || (m_exhausted && m_returned == m_taken); });
+        if (!slot.ready)
+        {
+            return false;
+        }
+
+        std::swap(result, slot.result); // The caller's object is reused by the next chunk of this slot
+        slot.ready = false;
+        ++m_returned;
+        lock.unlock();
+        m_slotFree.notify_all();
+        return true;
+    }
+
+    size_t GetThreadCount() const
+    {
+        return m_threads.size();
+    }
+
+private:
+    struct Slot
+    {
+        bool ready = false;
+        Result result;
+    };
+
+    void Work()
+    {
+        Task task;
+        Result result;
+        for (;;)
+        {
+            size_t index;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_slotFree.wait(lock, [this]() { return m_stopped || m_exhausted || m_taken - m_returned < m_slots.size(); });
+                if (m_stopped || m_exhausted)
+                {
+                    break;
+                }
+                if (!m_take(task))
+                {
+                    m_exhausted = true;
+                    lock.unlock();
+                    m_slotFree.notify_all(); // Other workers don't need to wait anymore
+                    break;
+                }
+                index = m_taken++;
+            }
+
+            m_process(task, result);
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                Slot& slot = m_slots[index % m_slots.size()];
+                std::swap(slot.result, result);
+                slot.ready = true;
+            }
+            m_chunkReady.notify_one();
+        }
+        m_chunkReady.notify_one(); // The consumer may wait for the end of the input
+    }
+
+private:
+    const TakeFunction m_take;
+    const ProcessFunction m_process;
+    std::vector<Slot> m_slots; // Reorder buffer, chunk i goes to slot i % size
+    size_t m_taken;
+    size_t m_returned;
+    bool m_exhausted;
+    bool m_stopped;
+    std::mutex m_mutex;
+    std::condition_variable m_chunkReady;
+    std::condition_variable m_slotFree;
+    std::vector<std::thread> m_threads;
+};
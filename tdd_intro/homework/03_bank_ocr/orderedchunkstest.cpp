@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "orderedchunks.h"
+
+namespace
+{
+    // Workers over the numbers 0..count-1, each result is the number itself
+    class NumberWorkers
+    {
+    public:
+        NumberWorkers(size_t count, size_t threads, bool slowEven = false)
+            : m_count(count)
+            , m_next(0)
+            , m_workers(threads, 2,
+                        [this](size_t& number)
+                        {
+                            if (m_next == m_count)
+                            {
+                                return false;
+                            }
+                            number = m_next++;
+                            return true;
+                        },
+                        [slowEven](size_t number, size_t& result)
+                        {
+                            if (slowEven && number % 2 == 0)
+                            {
+                                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                            }
+                            result = number;
+                        })
+        { }
+
+        bool Next(size_t& result) { return m_workers.Next(result); }
+
+    private:
+        const size_t m_count;
+        size_t m_next;
+        OrderedChunkWorkers<size_t, size_t> m_workers;
+    };
+}
+
+TEST(OrderedChunkWorkersTest, ReturnsNothingWithoutChunks)
+{
+    NumberWorkers workers(0, 4);
+    size_t result;
+
+    EXPECT_FALSE(workers.Next(result));
+}
+
+TEST(OrderedChunkWorkersTest, ReturnsResultsInInputOrder)
+{
+    NumberWorkers workers(100, 4, true);
+    std::vector<size_t> results;
+    size_t result;
+    while (workers.Next(result))
+    {
+        results.push_back(result);
+    }
+
+    ASSERT_EQ(100u, results.size());
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        EXPECT_EQ(i, results[i]);
+    }
+}
+
+TEST(OrderedChunkWorkersTest, StopsWithoutReturningAllChunks)
+{
+    NumberWorkers workers(1000, 4);
+    size_t result;
+
+    ASSERT_TRUE(workers.Next(result));
+    EXPECT_EQ(0u, result);
+}
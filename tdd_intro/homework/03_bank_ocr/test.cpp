@@ -86,112 +86,213 @@ Example input and output
 */
 #include <gtest/gtest.h>
 #include <string>
+#include <string_view>
+#include "ocrdecoder.h"
 
 const unsigned short g_digitLen = 3;
 const unsigned short g_linesInDigit = 3;
 struct Digit
 {
-    std::string lines[g_linesInDigit];
+    std::string_view lines[g_linesInDigit];
 };
 
 const unsigned short g_digitsOnDisplay = 9;
 struct Display
 {
-    std::string lines[g_linesInDigit];
+    char lines[g_linesInDigit][g_digitsOnDisplay * g_digitLen + 1];
 };
 
-const Digit s_digit0 = { " _ ",
-                         "| |",
-                         "|_|"
-                       };
-const Digit s_digit1 = { "   ",
-                         "  |",
-                         "  |"
-                       };
-const Digit s_digit2 = { " _ ",
-                         " _|",
-                         "|_ "
-                       };
-const Digit s_digit3 = { " _ ",
-                         " _|",
-                         " _|"
-                       };
-const Digit s_digit4 = { "   ",
-                         "|_|",
-                         "  |"
-                       };
-const Digit s_digit5 = { " _ ",
-                         "|_ ",
-                         " _|"
-                       };
-const Digit s_digit6 = { " _ ",
-                         "|_ ",
-                         "|_|"
-                       };
-const Digit s_digit7 = { " _ ",
-                         "  |",
-                         "  |"
-                       };
-const Digit s_digit8 = { " _ ",
-                         "|_|",
-                         "|_|"
-                       };
-const Digit s_digit9 = { " _ ",
-                         "|_|",
-                         " _|"
-                       };
-
-const Display s_displayAll0 = { " _  _  _  _  _  _  _  _  _ ",
-                                "| || || || || || || || || |",
-                                "|_||_||_||_||_||_||_||_||_|"
+// Whether the shared glyph table renders the digits exactly as the display
+constexpr bool IsRenderedAs(std::string_view digits, const Display& display)
+{
+    const EntryText text = RenderEntry(digits);
+    for (size_t row = 0; row < g_linesInDigit; ++row)
+    {
+        for (size_t i = 0; i < g_entryWidth; ++i)
+        {
+            if (text.lines[row][i] != display.lines[row][i])
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+constexpr Digit s_digit0 = { " _ ",
+                             "| |",
+                             "|_|"
+                           };
+constexpr Digit s_digit1 = { "   ",
+                             "  |",
+                             "  |"
+                           };
+constexpr Digit s_digit2 = { " _ ",
+                             " _|",
+                             "|_ "
+                           };
+constexpr Digit s_digit3 = { " _ ",
+                             " _|",
+                             " _|"
+                           };
+constexpr Digit s_digit4 = { "   ",
+                             "|_|",
+                             "  |"
+                           };
+constexpr Digit s_digit5 = { " _ ",
+                             "|_ ",
+                             " _|"
+                           };
+constexpr Digit s_digit6 = { " _ ",
+                             "|_ ",
+                             "|_|"
+                           };
+constexpr Digit s_digit7 = { " _ ",
+                             "  |",
+                             "  |"
+                           };
+constexpr Digit s_digit8 = { " _ ",
+                             "|_|",
+                             "|_|"
+                           };
+constexpr Digit s_digit9 = { " _ ",
+                             "|_|",
+                             " _|"
+                           };
+
+constexpr Display s_displayAll0 = { " _  _  _  _  _  _  _  _  _ ",
+                                    "| || || || || || || || || |",
+                                    "|_||_||_||_||_||_||_||_||_|"
 };
 
-const Display s_displayAll1 = { "                           ",
-                                "  |  |  |  |  |  |  |  |  |",
-                                "  |  |  |  |  |  |  |  |  |"
+constexpr Display s_displayAll1 = { "                           ",
+                                    "  |  |  |  |  |  |  |  |  |",
+                                    "  |  |  |  |  |  |  |  |  |"
 };
 
-const Display s_displayAll2 = {  " _  _  _  _  _  _  _  _  _ ",
-                                 " _| _| _| _| _| _| _| _| _|",
-                                 "|_ |_ |_ |_ |_ |_ |_ |_ |_ "
+constexpr Display s_displayAll2 = {  " _  _  _  _  _  _  _  _  _ ",
+                                     " _| _| _| _| _| _| _| _| _|",
+                                     "|_ |_ |_ |_ |_ |_ |_ |_ |_ "
 };
 
-const Display s_displayAll3 = { " _  _  _  _  _  _  _  _  _ ",
-                                " _| _| _| _| _| _| _| _| _|",
-                                " _| _| _| _| _| _| _| _| _|"
+constexpr Display s_displayAll3 = { " _  _  _  _  _  _  _  _  _ ",
+                                    " _| _| _| _| _| _| _| _| _|",
+                                    " _| _| _| _| _| _| _| _| _|"
 };
 
-const Display s_displayAll4 = { "                           ",
-                                "|_||_||_||_||_||_||_||_||_|",
-                                "  |  |  |  |  |  |  |  |  |"
+constexpr Display s_displayAll4 = { "                           ",
+                                    "|_||_||_||_||_||_||_||_||_|",
+                                    "  |  |  |  |  |  |  |  |  |"
 };
 
-const Display s_displayAll5 = { " _  _  _  _  _  _  _  _  _ ",
-                                "|_ |_ |_ |_ |_ |_ |_ |_ |_ ",
-                                " _| _| _| _| _| _| _| _| _|"
+constexpr Display s_displayAll5 = { " _  _  _  _  _  _  _  _  _ ",
+                                    "|_ |_ |_ |_ |_ |_ |_ |_ |_ ",
+                                    " _| _| _| _| _| _| _| _| _|"
 };
 
-const Display s_displayAll6 = { " _  _  _  _  _  _  _  _  _ ",
-                                "|_ |_ |_ |_ |_ |_ |_ |_ |_ ",
-                                "|_||_||_||_||_||_||_||_||_|"
+constexpr Display s_displayAll6 = { " _  _  _  _  _  _  _  _  _ ",
+                                    "|_ |_ |_ |_ |_ |_ |_ |_ |_ ",
+                                    "|_||_||_||_||_||_||_||_||_|"
 };
 
-const Display s_displayAll7 = { " _  _  _  _  _  _  _  _  _ ",
-                                "  |  |  |  |  |  |  |  |  |",
-                                "  |  |  |  |  |  |  |  |  |"
+constexpr Display s_displayAll7 = { " _  _  _  _  _  _  _  _  _ ",
+                                    "  |  |  |  |  |  |  |  |  |",
+                                    "  |  |  |  |  |  |  |  |  |"
 };
 
-const Display s_displayAll8 = { " _  _  _  _  _  _  _  _  _ ",
-                                "|_||_||_||_||_||_||_||_||_|",
-                                "|_||_||_||_||_||_||_||_||_|"
+constexpr Display s_displayAll8 = { " _  _  _  _  _  _  _  _  _ ",
+                                    "|_||_||_||_||_||_||_||_||_|",
+                                    "|_||_||_||_||_||_||_||_||_|"
 };
 
-const Display s_displayAll9 = { " _  _  _  _  _  _  _  _  _ ",
-                                "|_||_||_||_||_||_||_||_||_|",
-                                " _| _| _| _| _| _| _| _| _|"
+constexpr Display s_displayAll9 = { " _  _  _  _  _  _  _  _  _ ",
+                                    "|_||_||_||_||_||_||_||_||_|",
+                                    " _| _| _| _| _| _| _| _| _|"
 };
 
-const Display s_display123456789 = { "    _  _     _  _  _  _  _ ",
-                                     "  | _| _||_||_ |_   ||_||_|",
-                                     "  ||_  _|  | _||_|  ||_| _|"
+constexpr Display s_display123456789 = { "    _  _     _  _  _  _  _ ",
+                                         "  | _| _||_||_ |_   ||_||_|",
+                                         "  ||_  _|  | _||_|  ||_| _|"
 };
+
+static_assert(IsRenderedAs("000000000", s_displayAll0));
+static_assert(IsRenderedAs("111111111", s_displayAll1));
+static_assert(IsRenderedAs("222222222", s_displayAll2));
+static_assert(IsRenderedAs("333333333", s_displayAll3));
+static_assert(IsRenderedAs("444444444", s_displayAll4));
+static_assert(IsRenderedAs("555555555", s_displayAll5));
+static_assert(IsRenderedAs("666666666", s_displayAll6));
+static_assert(IsRenderedAs("777777777", s_displayAll7));
+static_assert(IsRenderedAs("888888888", s_displayAll8));
+static_assert(IsRenderedAs("999999999", s_displayAll9));
+static_assert(IsRenderedAs("123456789", s_display123456789));
+static_assert(DecodeMask(GetCellMask(s_digit5.lines[0], s_digit5.lines[1], s_digit5.lines[2], 0)) == '5');
+
+namespace
+{
+    std::string Decode(const Display& display)
+    {
+        char digits[g_accountDigits];
+        DecodeEntry(display.lines[0], display.lines[1], display.lines[2], digits);
+        return std::string(digits, g_accountDigits);
+    }
+
+    char Decode(const Digit& digit)
+    {
+        return DecodeMask(GetCellMask(digit.lines[0], digit.lines[1], digit.lines[2], 0));
+    }
+}
+
+TEST(BankOcrTest, DecodesSingleDigits)
+{
+    const Digit* digits[] = { &s_digit0, &s_digit1, &s_digit2, &s_digit3, &s_digit4,
+                              &s_digit5, &s_digit6, &s_digit7, &s_digit8, &s_digit9 };
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ('0' + i, Decode(*digits[i]));
+    }
+}
+
+TEST(BankOcrTest, DecodesDisplaysOfSameDigits)
+{
+    EXPECT_EQ("000000000", Decode(s_displayAll0));
+    EXPECT_EQ("111111111", Decode(s_displayAll1));
+    EXPECT_EQ("222222222", Decode(s_displayAll2));
+    EXPECT_EQ("333333333", Decode(s_displayAll3));
+    EXPECT_EQ("444444444", Decode(s_displayAll4));
+    EXPECT_EQ("555555555", Decode(s_displayAll5));
+    EXPECT_EQ("666666666", Decode(s_displayAll6));
+    EXPECT_EQ("777777777", Decode(s_displayAll7));
+    EXPECT_EQ("888888888", Decode(s_displayAll8));
+    EXPECT_EQ("999999999", Decode(s_displayAll9));
+}
+
+TEST(BankOcrTest, DecodesDifferentDigits)
+{
+    EXPECT_EQ("123456789", Decode(s_display123456789));
+}
+
+TEST(BankOcrTest, DecodesLinesWithTrimmedTrailingSpaces)
+{
+    const Display display = { "",
+                              "  |  |  |  |  |  |  |  |  |",
+                              "  |  |  |  |  |  |  |  |  |" };
+    EXPECT_EQ("111111111", Decode(display));
+    const Display shortLines = { "    _",
+                                 "  | _|",
+                                 "  ||_" };
+    char digits[g_accountDigits];
+    EXPECT_FALSE(DecodeEntry(shortLines.lines[0], shortLines.lines[1], shortLines.lines[2], digits));
+    EXPECT_EQ("12", std::string(digits, 2));
+}
+
+TEST(BankOcrTest, MarksIllegibleDigits)
+{
+    const Display display = { "    _  _     _  _  _  _  _ ",
+                              "  | _| _||_||_ |_   ||_||_|",
+                              "  ||_  _|  | _|| |  ||_| _|" };
+    char digits[g_accountDigits];
+
+    EXPECT_FALSE(DecodeEntry(display.lines[0], display.lines[1], display.lines[2], digits));
+    EXPECT_EQ("12345?789", std::string(digits, g_accountDigits));
+}
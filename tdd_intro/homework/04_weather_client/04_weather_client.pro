@@ -6,4 +6,17 @@ CONFIG -= app_bundle
 CONFIG -= qt
 
 SOURCES += \
-    test.cpp
+    test.cpp \
+    cachingweatherserver.cpp \
+    cachingweatherservertest.cpp \
+    cachingweatherserverbenchmark.cpp \
+    weatherclient.cpp \
+    weatherclienttest.cpp \
+    weatherclientbenchmark.cpp
+
+HEADERS += \
+    iweatherserver.h \
+    iweatherclient.h \
+    cachingweatherserver.h \
+    weatherclient.h \
+    mocks.h
@@ -0,0 +1,78 @@
+#include <algorithm>
+
+#include "cachingweatherserver.h"
+
+CachingWeatherServer::CachingWeatherServer(IWeatherServer& server, size_t capacity)
+    : m_server(server)
+    , m_capacity(std::max<size_t>(capacity, 1))
+{
+}
+
+std::string CachingWeatherServer::GetWeather(const std::string& request)
+{
+    std::promise<std::string> response;
+    std::shared_future<std::string> pending;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto cached = m_index.find(request);
+        if (cached != m_index.end())
+        {
+            m_entries.splice(m_entries.begin(), m_entries, cached->second);
+            return cached->second->second;
+        }
+
+        auto sent = m_pending.find(request);
+        if (sent != m_pending.end())
+        {
+            pending = sent->second;
+        }
+        else
+        {
+            m_pending.emplace(request, response.get_future().share());
+        }
+    }
+    if (pending.valid())
+    {
+        return pending.get();
+    }
+
+    std::string weather;
+    try
+    {
+        weather = m_server.GetWeather(request);
+    }
+    catch (...)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending.erase(request);
+        }
+        response.set_exception(std::current_exception());
+        throw;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Insert(request, weather);
+        m_pending.erase(request);
+    }
+    response.set_value(weather);
+    return weather;
+}
+
+size_t CachingWeatherServer::GetCachedCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+void CachingWeatherServer::Insert(const std::string& request, const std::string& response)
+{
+    if (m_entries.size() == m_capacity)
+    {
+        m_index.erase(m_entries.back().first);
+        m_entries.pop_back();
+    }
+    m_entries.emplace_front(request, response);
+    m_index[request] = m_entries.begin();
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <future>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "iweatherserver.h"
+
+/*
+ * Decorator of IWeatherServer, which remembers the responses of the server.
+ *
+ * Every statistic of a date needs the same four requests, so the responses are kept in the LRU cache
+ * by the request string. Invalid requests get empty responses, which are cached as well, so they don't
+ * reach the server again. Concurrent identical requests are coalesced: the first one goes to the server
+ * and the others wait for its response. Failed requests are not cached, their exception is rethrown
+ * to all the waiting callers.
+ *
+ * Decorator is thread safe. Different requests go to the server concurrently, so it must be thread safe too.
+*/
+
+class CachingWeatherServer : public IWeatherServer
+{
+public:
+    static const size_t s_defaultCapacity = 1024;
+
+    explicit CachingWeatherServer(IWeatherServer& server, size_t capacity = s_defaultCapacity);
+
+    std::string GetWeather(const std::string& request) override;
+
+    size_t GetCachedCount() const;
+
+private:
+    typedef std::list<std::pair<std::string, std::string>> Entries;
+
+    // Must be called under the lock
+    void Insert(const std::string& request, const std::string& response);
+
+private:
+    IWeatherServer& m_server;
+    const size_t m_capacity;
+    mutable std::mutex m_mutex;
+    Entries m_entries; // The most recently used first
+    std::unordered_map<std::string, Entries::iterator> m_index;
+    std::unordered_map<std::string, std::shared_future<std::string>> m_pending; // Requests sent to the server
+};
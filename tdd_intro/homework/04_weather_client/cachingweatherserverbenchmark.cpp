@@ -0,0 +1,61 @@
+// Server calls and time to compute the five statistics of the dates, with and without the cache,
+// when the server takes 1 ms per request. Several clients compute the same dates at once.
+// It is disabled by default, run it with --gtest_also_run_disabled_tests.
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "cachingweatherserver.h"
+#include "mocks.h"
+
+namespace
+{
+    const size_t s_statistics = 5;
+    const size_t s_clients = 4;
+    const char* const s_dates[] = { "31.08.2018", "01.09.2018", "02.09.2018", "03.09.2018" };
+    const char* const s_times[] = { "03:00", "09:00", "15:00", "21:00" };
+
+    // Every statistic requests the four samples of the date. Returns milliseconds.
+    double Measure(IWeatherServer& server)
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> clients;
+        for (size_t i = 0; i < s_clients; ++i)
+        {
+            clients.emplace_back([&server]()
+            {
+                for (const char* date : s_dates)
+                {
+                    for (size_t statistic = 0; statistic < s_statistics; ++statistic)
+                    {
+                        for (const char* time : s_times)
+                        {
+                            server.GetWeather(std::string(date) + ";" + time);
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& client : clients)
+        {
+            client.join();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+TEST(CachingWeatherServerBenchmark, DISABLED_ServerCallsAndLatency)
+{
+    WeatherServerFake direct(std::chrono::milliseconds(1));
+    const double directTime = Measure(direct);
+
+    WeatherServerFake backend(std::chrono::milliseconds(1));
+    CachingWeatherServer cache(backend);
+    const double cachedTime = Measure(cache);
+
+    std::cout << "Without cache: " << direct.GetCalls() << " server calls, " << directTime << " ms" << std::endl;
+    std::cout << "With cache: " << backend.GetCalls() << " server calls, " << cachedTime << " ms" << std::endl;
+    EXPECT_EQ(sizeof(s_dates) / sizeof(s_dates[0]) * 4, backend.GetCalls());
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "cachingweatherserver.h"
+#include "mocks.h"
+
+using testing::Return;
+using testing::Throw;
+
+TEST(CachingWeatherServerTest, ReturnsResponseOfServer)
+{
+    WeatherServerFake server;
+    CachingWeatherServer cache(server);
+    EXPECT_EQ("20;181;5.1", cache.GetWeather("31.08.2018;03:00"));
+}
+
+TEST(CachingWeatherServerTest, AsksServerOncePerRequest)
+{
+    WeatherServerMock server;
+    CachingWeatherServer cache(server);
+    EXPECT_CALL(server, GetWeather("31.08.2018;03:00")).WillOnce(Return("20;181;5.1"));
+    EXPECT_CALL(server, GetWeather("31.08.2018;09:00")).WillOnce(Return("23;204;4.9"));
+
+    EXPECT_EQ("20;181;5.1", cache.GetWeather("31.08.2018;03:00"));
+    EXPECT_EQ("23;204;4.9", cache.GetWeather("31.08.2018;09:00"));
+    EXPECT_EQ("20;181;5.1", cache.GetWeather("31.08.2018;03:00"));
+    EXPECT_EQ("23;204;4.9", cache.GetWeather("31.08.2018;09:00"));
+}
+
+TEST(CachingWeatherServerTest, CachesEmptyResponses)
+{
+    WeatherServerMock server;
+    CachingWeatherServer cache(server);
+    EXPECT_CALL(server, GetWeather("31.08.2018;04:00")).WillOnce(Return(""));
+
+    EXPECT_EQ("", cache.GetWeather("31.08.2018;04:00"));
+    EXPECT_EQ("", cache.GetWeather("31.08.2018;04:00"));
+}
+
+TEST(CachingWeatherServerTest, EvictsLeastRecentlyUsedResponse)
+{
+    WeatherServerFake server;
+    CachingWeatherServer cache(server, 2);
+    cache.GetWeather("31.08.2018;03:00");
+    cache.GetWeather("31.08.2018;09:00");
+    cache.GetWeather("31.08.2018;03:00");
+    cache.GetWeather("31.08.2018;15:00"); // Evicts 09:00
+    EXPECT_EQ(3u, server.GetCalls());
+    EXPECT_EQ(2u, cache.GetCachedCount());
+
+    cache.GetWeather("31.08.2018;03:00");
+    EXPECT_EQ(3u, server.GetCalls());
+    cache.GetWeather("31.08.2018;09:00");
+    EXPECT_EQ(4u, server.GetCalls());
+}
+
+TEST(CachingWeatherServerTest, CoalescesConcurrentRequests)
+{
+    WeatherServerFake server(std::chrono::milliseconds(100));
+    CachingWeatherServer cache(server);
+    std::vector<std::thread> threads;
+    std::vector<std::string> responses(8);
+    for (size_t i = 0; i < responses.size(); ++i)
+    {
+        threads.emplace_back([&cache, &responses, i]() { responses[i] = cache.GetWeather("01.09.2018;15:00"); });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(1u, server.GetCalls());
+    EXPECT_EQ(std::vector<std::string>(responses.size(), "31;109;4.0"), responses);
+}
+
+TEST(CachingWeatherServerTest, DoesNotCacheFailures)
+{
+    WeatherServerMock server;
+    CachingWeatherServer cache(server);
+    EXPECT_CALL(server, GetWeather("31.08.2018;03:00"))
+        .WillOnce(Throw(std::runtime_error("Network is down.")))
+        .WillOnce(Return("20;181;5.1"));
+
+    EXPECT_THROW(cache.GetWeather("31.08.2018;03:00"), std::runtime_error);
+    EXPECT_EQ("20;181;5.1", cache.GetWeather("31.08.2018;03:00"));
+    EXPECT_EQ(1u, cache.GetCachedCount());
+}
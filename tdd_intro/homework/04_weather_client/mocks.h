@@ -0,0 +1,61 @@
+#pragma once
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+#include "iweatherserver.h"
+
+class WeatherServerMock : public IWeatherServer
+{
+public:
+    MOCK_METHOD1(GetWeather, std::string(const std::string& request));
+};
+
+// Fake server with the collected responses of the real one, empty response for any other request.
+// Each request takes the given delay, to emulate the network round trip. Thread safe.
+class WeatherServerFake : public IWeatherServer
+{
+public:
+    explicit WeatherServerFake(std::chrono::microseconds delay = std::chrono::microseconds(0))
+        : m_delay(delay)
+        , m_calls(0)
+        , m_responses({
+            { "31.08.2018;03:00", "20;181;5.1" },
+            { "31.08.2018;09:00", "23;204;4.9" },
+            { "31.08.2018;15:00", "33;193;4.3" },
+            { "31.08.2018;21:00", "26;179;4.5" },
+            { "01.09.2018;03:00", "19;176;4.2" },
+            { "01.09.2018;09:00", "22;131;4.1" },
+            { "01.09.2018;15:00", "31;109;4.0" },
+            { "01.09.2018;21:00", "24;127;4.1" },
+            { "02.09.2018;03:00", "21;158;3.8" },
+            { "02.09.2018;09:00", "25;201;3.5" },
+            { "02.09.2018;15:00", "34;258;3.7" },
+            { "02.09.2018;21:00", "27;299;4.0" }
+        })
+    {
+    }
+
+    std::string GetWeather(const std::string& request) override
+    {
+        ++m_calls;
+        if (m_delay.count())
+        {
+            std::this_thread::sleep_for(m_delay);
+        }
+        auto response = m_responses.find(request);
+        return response == m_responses.end() ? std::string() : response->second;
+    }
+
+    size_t GetCalls() const
+    {
+        return m_calls;
+    }
+
+private:
+    const std::chrono::microseconds m_delay;
+    std::atomic<size_t> m_calls;
+    const std::map<std::string, std::string> m_responses;
+};
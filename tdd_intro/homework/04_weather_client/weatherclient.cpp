@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+
+#include "weatherclient.h"
+
+namespace
+{
+    const char* const s_sampleTimes[] = { ";03:00", ";09:00", ";15:00", ";21:00" };
+    const size_t s_sampleCount = sizeof(s_sampleTimes) / sizeof(s_sampleTimes[0]);
+    const double s_pi = 3.14159265358979323846;
+    const double s_fullCircle = 360;
+
+    double ToRadians(double degrees)
+    {
+        return degrees * s_pi / (s_fullCircle / 2);
+    }
+
+    double ToDegrees(double radians)
+    {
+        return radians * (s_fullCircle / 2) / s_pi;
+    }
+
+    void CheckResponse(bool valid, const std::string& response)
+    {
+        if (!valid)
+        {
+            throw std::runtime_error("Malformed weather response \"" + response + "\".");
+        }
+    }
+}
+
+Weather ParseWeather(const std::string& response)
+{
+    const char* position = response.c_str();
+    char* end = nullptr;
+    Weather weather;
+
+    const long temperature = std::strtol(position, &end, 10);
+    CheckResponse(end != position && *end == ';', response);
+    weather.temperature = static_cast<short>(temperature);
+    position = end + 1;
+
+    const long direction = std::strtol(position, &end, 10);
+    CheckResponse(end != position && *end == ';' && direction >= 0 && direction < s_fullCircle, response);
+    weather.windDirection = static_cast<unsigned short>(direction);
+    position = end + 1;
+
+    weather.windSpeed = std::strtod(position, &end);
+    CheckResponse(end != position && *end == '\0', response);
+    return weather;
+}
+
+DailySummary GetDailySummary(IWeatherServer& server, const std::string& date)
+{
+    DailySummary summary;
+    summary.minimumTemperature = std::numeric_limits<double>::max();
+    summary.maximumTemperature = std::numeric_limits<double>::lowest();
+    double temperatureSum = 0;
+    double directionSin = 0;
+    double directionCos = 0;
+    for (size_t i = 0; i < s_sampleCount; ++i)
+    {
+        const std::string request = date + s_sampleTimes[i];
+        const std::string response = server.GetWeather(request);
+        if (response.empty())
+        {
+            throw std::runtime_error("No weather for \"" + request + "\".");
+        }
+
+        const Weather weather = ParseWeather(response);
+        temperatureSum += weather.temperature;
+        summary.minimumTemperature = std::min<double>(summary.minimumTemperature, weather.temperature);
+        summary.maximumTemperature = std::max<double>(summary.maximumTemperature, weather.temperature);
+        summary.maximumWindSpeed = std::max(summary.maximumWindSpeed, weather.windSpeed);
+        directionSin += std::sin(ToRadians(weather.windDirection));
+        directionCos += std::cos(ToRadians(weather.windDirection));
+    }
+
+    summary.averageTemperature = temperatureSum / s_sampleCount;
+    const double direction = ToDegrees(std::atan2(directionSin, directionCos));
+    summary.averageWindDirection = direction < 0 ? direction + s_fullCircle : direction;
+    return summary;
+}
+
+double WeatherClient::GetAverageTemperature(IWeatherServer& server, const std::string& date)
+{
+    return GetDailySummary(server, date).averageTemperature;
+}
+
+double WeatherClient::GetMinimumTemperature(IWeatherServer& server, const std::string& date)
+{
+    return GetDailySummary(server, date).minimumTemperature;
+}
+
+double WeatherClient::GetMaximumTemperature(IWeatherServer& server, const std::string& date)
+{
+    return GetDailySummary(server, date).maximumTemperature;
+}
+
+double WeatherClient::GetAverageWindDirection(IWeatherServer& server, const std::string& date)
+{
+    return GetDailySummary(server, date).averageWindDirection;
+}
+
+double WeatherClient::GetMaximumWindSpeed(IWeatherServer& server, const std::string& date)
+{
+    return GetDailySummary(server, date).maximumWindSpeed;
+}
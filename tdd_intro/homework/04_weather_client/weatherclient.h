@@ -0,0 +1,35 @@
+#pragma once
+#include <string>
+#include "iweatherclient.h"
+
+/*
+ * Statistics of the weather for a date, made of the four samples the server has for it.
+ *
+ * GetDailySummary requests the samples of 03:00, 09:00, 15:00 and 21:00 once and computes all the statistics
+ * in one pass. Wind direction is averaged on the circle, so 350 and 10 degrees give 0, not 180.
+ * WeatherClient statistics are views of the summary. Summary of a date, which the server doesn't know
+ * (empty response), or of a malformed response throws std::runtime_error.
+*/
+
+struct DailySummary
+{
+    double averageTemperature = 0;
+    double minimumTemperature = 0;
+    double maximumTemperature = 0;
+    double averageWindDirection = 0; // Degrees in [0, 360)
+    double maximumWindSpeed = 0;
+};
+
+// Parses the server response "<temperature>;<wind direction>;<wind speed>".
+Weather ParseWeather(const std::string& response);
+DailySummary GetDailySummary(IWeatherServer& server, const std::string& date);
+
+class WeatherClient : public IWeatherClient
+{
+public:
+    double GetAverageTemperature(IWeatherServer& server, const std::string& date) override;
+    double GetMinimumTemperature(IWeatherServer& server, const std::string& date) override;
+    double GetMaximumTemperature(IWeatherServer& server, const std::string& date) override;
+    double GetAverageWindDirection(IWeatherServer& server, const std::string& date) override;
+    double GetMaximumWindSpeed(IWeatherServer& server, const std::string& date) override;
+};
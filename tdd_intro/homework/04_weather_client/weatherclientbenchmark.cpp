@@ -0,0 +1,54 @@
+// Days per second, when all five statistics of the day are asked one by one from the client,
+// and when they are taken from one daily summary. Server answers without delay, so the cost is
+// the requests and the parsing.
+// It is disabled by default, run it with --gtest_also_run_disabled_tests.
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "weatherclient.h"
+#include "mocks.h"
+
+namespace
+{
+    const size_t s_days = 300000;
+    const char* const s_dates[] = { "31.08.2018", "01.09.2018", "02.09.2018" };
+    const size_t s_dateCount = sizeof(s_dates) / sizeof(s_dates[0]);
+
+    template <typename Statistics>
+    double Measure(Statistics statistics)
+    {
+        double checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t day = 0; day < s_days; ++day)
+        {
+            checksum += statistics(s_dates[day % s_dateCount]);
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        EXPECT_NE(0, checksum);
+        return s_days / seconds;
+    }
+}
+
+TEST(WeatherClientBenchmark, DISABLED_DaysPerSecond)
+{
+    WeatherServerFake separateServer;
+    WeatherClient client;
+    const double separate = Measure([&separateServer, &client](const std::string& date)
+    {
+        return client.GetAverageTemperature(separateServer, date) + client.GetMinimumTemperature(separateServer, date) +
+               client.GetMaximumTemperature(separateServer, date) + client.GetAverageWindDirection(separateServer, date) +
+               client.GetMaximumWindSpeed(separateServer, date);
+    });
+
+    WeatherServerFake summaryServer;
+    const double summarized = Measure([&summaryServer](const std::string& date)
+    {
+        const DailySummary summary = GetDailySummary(summaryServer, date);
+        return summary.averageTemperature + summary.minimumTemperature + summary.maximumTemperature +
+               summary.averageWindDirection + summary.maximumWindSpeed;
+    });
+
+    std::cout << "Five statistics: " << separate << " days/s, " << separateServer.GetCalls() / s_days << " requests per day" << std::endl;
+    std::cout << "Daily summary: " << summarized << " days/s, " << summaryServer.GetCalls() / s_days << " requests per day" << std::endl;
+}
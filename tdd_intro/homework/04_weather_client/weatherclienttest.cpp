@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <stdexcept>
+#include "weatherclient.h"
+#include "mocks.h"
+
+using testing::_;
+using testing::Return;
+
+TEST(WeatherClientTest, ParsesResponse)
+{
+    Weather expected;
+    expected.temperature = -20;
+    expected.windDirection = 181;
+    expected.windSpeed = 5.1;
+    EXPECT_TRUE(ParseWeather("-20;181;5.1") == expected);
+}
+
+TEST(WeatherClientTest, ThrowsOnMalformedResponse)
+{
+    EXPECT_THROW(ParseWeather(""), std::runtime_error);
+    EXPECT_THROW(ParseWeather("20;181"), std::runtime_error);
+    EXPECT_THROW(ParseWeather("20;360;5.1"), std::runtime_error);
+    EXPECT_THROW(ParseWeather("20;181;5.1x"), std::runtime_error);
+    EXPECT_THROW(ParseWeather("a;181;5.1"), std::runtime_error);
+}
+
+TEST(WeatherClientTest, SummarizesDayInOnePass)
+{
+    WeatherServerFake server;
+    const DailySummary summary = GetDailySummary(server, "31.08.2018");
+    EXPECT_EQ(4u, server.GetCalls());
+    EXPECT_DOUBLE_EQ(25.5, summary.averageTemperature);
+    EXPECT_DOUBLE_EQ(20, summary.minimumTemperature);
+    EXPECT_DOUBLE_EQ(33, summary.maximumTemperature);
+    EXPECT_NEAR(189.23, summary.averageWindDirection, 0.01);
+    EXPECT_DOUBLE_EQ(5.1, summary.maximumWindSpeed);
+}
+
+TEST(WeatherClientTest, RequestsFourSamplesOfDate)
+{
+    WeatherServerMock server;
+    EXPECT_CALL(server, GetWeather("01.09.2018;03:00")).WillOnce(Return("19;176;4.2"));
+    EXPECT_CALL(server, GetWeather("01.09.2018;09:00")).WillOnce(Return("22;131;4.1"));
+    EXPECT_CALL(server, GetWeather("01.09.2018;15:00")).WillOnce(Return("31;109;4.0"));
+    EXPECT_CALL(server, GetWeather("01.09.2018;21:00")).WillOnce(Return("24;127;4.1"));
+    EXPECT_NEAR(135.14, GetDailySummary(server, "01.09.2018").averageWindDirection, 0.01);
+}
+
+TEST(WeatherClientTest, AveragesWindDirectionOnCircle)
+{
+    WeatherServerMock server;
+    EXPECT_CALL(server, GetWeather(_))
+        .WillOnce(Return("0;350;1.0"))
+        .WillOnce(Return("0;10;1.0"))
+        .WillOnce(Return("0;340;1.0"))
+        .WillOnce(Return("0;15;1.0"));
+    const double direction = GetDailySummary(server, "01.01.2019").averageWindDirection;
+    EXPECT_GE(direction, 350);
+    EXPECT_LT(direction, 360);
+}
+
+TEST(WeatherClientTest, ThrowsForUnknownDate)
+{
+    WeatherServerFake server;
+    EXPECT_THROW(GetDailySummary(server, "03.09.2018"), std::runtime_error);
+}
+
+TEST(WeatherClientTest, StatisticsAreViewsOfSummary)
+{
+    WeatherServerFake server;
+    WeatherClient client;
+    const DailySummary summary = GetDailySummary(server, "02.09.2018");
+    EXPECT_DOUBLE_EQ(summary.averageTemperature, client.GetAverageTemperature(server, "02.09.2018"));
+    EXPECT_DOUBLE_EQ(21, client.GetMinimumTemperature(server, "02.09.2018"));
+    EXPECT_DOUBLE_EQ(34, client.GetMaximumTemperature(server, "02.09.2018"));
+    EXPECT_NEAR(229.22, client.GetAverageWindDirection(server, "02.09.2018"), 0.01);
+    EXPECT_DOUBLE_EQ(4.0, client.GetMaximumWindSpeed(server, "02.09.2018"));
+}